@@ -73,13 +73,13 @@ function reti_new_project(projectName, path)
         links { "stdc++", "uuid" }
     filter {}
 
-    -- Debug / Release
+    -- Debug / Release (SCI_LOG_TRACE / SCI_LOG_DEBUG below the active level are compiled out)
     filter "configurations:Debug"
-        defines {  string.upper(projectName) .. "_DEBUG" }
+        defines {  string.upper(projectName) .. "_DEBUG", "SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_TRACE" }
         symbols "On"
     filter {}
     filter "configurations:Release"
-        defines {  string.upper(projectName) .. "_RELEASE" }
+        defines {  string.upper(projectName) .. "_RELEASE", "SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_DEBUG" }
         optimize "On"
     filter {}
 end
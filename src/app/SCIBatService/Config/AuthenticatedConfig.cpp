@@ -1,5 +1,190 @@
 #include "AuthenticatedConfig.h"
 
+#include <sodium.h>
+
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <tuple>
+
+SCI::Util::AdaptiveLock SCI::BAT::Config::AuthenticateConfig::s_aclLock{ "config.acl" };
+SCI::Util::RcuPointer<SCI::BAT::Config::AuthenticateConfig::AclTable> SCI::BAT::Config::AuthenticateConfig::s_acl;
+SCI::Util::SharedSpinLock SCI::BAT::Config::AuthenticateConfig::s_validatorsLock;
+std::unordered_map<std::string, SCI::BAT::Config::AuthenticateConfig::Validator> SCI::BAT::Config::AuthenticateConfig::s_validators;
+SCI::Util::SharedSpinLock SCI::BAT::Config::AuthenticateConfig::s_watchersLock;
+std::vector<SCI::BAT::Config::AuthenticateConfig::Watcher> SCI::BAT::Config::AuthenticateConfig::s_watchers;
+uint64_t SCI::BAT::Config::AuthenticateConfig::s_nextWatchId = 1;
+
+SCI::BAT::Config::AuthenticateConfig::Transaction::Transaction(int currentPermissionLevel) :
+    m_permissionLevel(currentPermissionLevel)
+{
+
+}
+
+bool SCI::BAT::Config::AuthenticateConfig::Transaction::Write(const std::string& key, const nlohmann::json& data)
+{
+    std::string error;
+    Permissions permissions;
+    if (Validate(key, data, error) && GetStagedPermissions(key, permissions) && permissions.minWritePermissionLevel <= m_permissionLevel)
+    {
+        m_operations.push_back({ key, DataToJson({ permissions.minReadPermissionLevel, permissions.minWritePermissionLevel, permissions.minDeletePermissionLevel, data }) });
+        m_types.push_back(OperationType::Write);
+        return true;
+    }
+
+    return false;
+}
+
+bool SCI::BAT::Config::AuthenticateConfig::Transaction::Insert(const std::string& key, int permissionRead, int permissionWrite, int permissionDelete, const nlohmann::json& data)
+{
+    Permissions permissions;
+    if (!GetStagedPermissions(key, permissions))
+    {
+        Data ddata;
+        ddata.minReadPermissionLevel = permissionRead;
+        ddata.minWritePermissionLevel = permissionWrite;
+        ddata.minDeletePermissionLevel = permissionDelete;
+        ddata.configData = data;
+
+        m_operations.push_back({ key, DataToJson(ddata) });
+        m_types.push_back(OperationType::Insert);
+        return true;
+    }
+
+    return false;
+}
+
+bool SCI::BAT::Config::AuthenticateConfig::Transaction::Delete(const std::string& key)
+{
+    Permissions permissions;
+    if (GetStagedPermissions(key, permissions) && permissions.minDeletePermissionLevel <= m_permissionLevel)
+    {
+        m_operations.push_back({ key, nullptr, true });
+        m_types.push_back(OperationType::Delete);
+        return true;
+    }
+
+    return false;
+}
+
+SCI::BAT::Config::AuthenticateConfig::Transaction::CommitResult SCI::BAT::Config::AuthenticateConfig::Transaction::Commit()
+{
+    if (m_operations.empty())
+    {
+        return CommitResult::Committed;
+    }
+    // Checked again: A delete or import may have changed the settings since staging
+    Util::LockGuard janitor(s_aclLock);
+    auto acl = LoadAcl();
+    std::unordered_map<std::string, std::optional<Permissions>> stagedPermissions;
+    std::unordered_map<std::string, nlohmann::json> stagedData;
+    std::vector<nlohmann::json> previousData(m_operations.size());
+    for (size_t i = 0; i < m_operations.size(); i++)
+    {
+        auto& operation = m_operations[i];
+
+        // State of the key before the operation (earlier operations of the transaction first)
+        std::optional<Permissions> permissions;
+        auto itStaged = stagedPermissions.find(operation.key);
+        if (itStaged != stagedPermissions.end())
+        {
+            permissions = itStaged->second;
+            previousData[i] = stagedData[operation.key];
+        }
+        else
+        {
+            auto itAcl = acl->find(operation.key);
+            if (itAcl != acl->end())
+            {
+                permissions = itAcl->second;
+                auto record = UqlJson::Get().ReadConfigShared(operation.key);
+                previousData[i] = record && !record->empty() ? record->at("data") : nlohmann::json();
+            }
+        }
+
+        switch (m_types[i])
+        {
+            case OperationType::Write:
+                if (!permissions)
+                    return CommitResult::Conflict;
+                if (permissions->minWritePermissionLevel > m_permissionLevel)
+                    return CommitResult::Denied;
+                operation.value = DataToJson({ permissions->minReadPermissionLevel, permissions->minWritePermissionLevel, permissions->minDeletePermissionLevel, operation.value.at("data") });
+                break;
+            case OperationType::Insert:
+                if (permissions)
+                    return CommitResult::Conflict;
+                permissions = RecordPermissions(operation.value);
+                break;
+            case OperationType::Delete:
+                if (!permissions)
+                    return CommitResult::Conflict;
+                if (permissions->minDeletePermissionLevel > m_permissionLevel)
+                    return CommitResult::Denied;
+                permissions.reset();
+                break;
+        }
+        stagedPermissions[operation.key] = permissions;
+        stagedData[operation.key] = operation.erase ? nlohmann::json() : operation.value.at("data");
+    }
+
+    if (!UqlJson::Get().WriteBatch(m_operations))
+    {
+        return CommitResult::Failed;
+    }
+    UpdateAcl([this](AclTable& acl)
+        {
+            for (const auto& operation : m_operations)
+            {
+                if (operation.erase)
+                {
+                    acl.erase(operation.key);
+                }
+                else
+                {
+                    acl[operation.key] = RecordPermissions(operation.value);
+                }
+            }
+        });
+    janitor.Release();
+
+    // Watchers see the operations in order
+    for (size_t i = 0; i < m_operations.size(); i++)
+    {
+        const auto& operation = m_operations[i];
+        NotifyWatchers(operation.key, previousData[i], operation.erase ? nlohmann::json() : operation.value.at("data"));
+    }
+    return CommitResult::Committed;
+}
+
+std::vector<std::string> SCI::BAT::Config::AuthenticateConfig::Transaction::GetKeys() const
+{
+    std::vector<std::string> keys;
+    keys.reserve(m_operations.size());
+    for (const auto& operation : m_operations)
+    {
+        keys.push_back(operation.key);
+    }
+    return keys;
+}
+
+bool SCI::BAT::Config::AuthenticateConfig::Transaction::GetStagedPermissions(const std::string& key, Permissions& permissions) const
+{
+    // The last staged operation on the key is its current state
+    for (auto itOperation = m_operations.rbegin(); itOperation != m_operations.rend(); itOperation++)
+    {
+        if (itOperation->key == key)
+        {
+            if (itOperation->erase)
+                return false;
+            permissions = RecordPermissions(itOperation->value);
+            return true;
+        }
+    }
+
+    return AuthenticateConfig::GetPermissions(key, permissions);
+}
+
 nlohmann::json SCI::BAT::Config::AuthenticateConfig::DataToJson(const Data& data)
 {
     nlohmann::json out;
@@ -25,18 +210,37 @@ SCI::BAT::Config::AuthenticateConfig::Data SCI::BAT::Config::AuthenticateConfig:
 
 bool SCI::BAT::Config::AuthenticateConfig::WriteData(const std::string& key, int currentPermissionLevel, const nlohmann::json& data)
 {
-    nlohmann::json oldJsonData;
-    if (UqlJson::Get().ReadConfig(key, oldJsonData))
+    // Invalid values never reach the database (modules can read without checking again)
+    std::string error;
+    if (!Validate(key, data, error))
     {
-        Data oldData = JsonToData(oldJsonData);
+        return false;
+    }
 
-        if (oldData.minWritePermissionLevel <= currentPermissionLevel)
-        {
-            oldData.configData = data;
+    // Denied without locking
+    Permissions permissions;
+    if (!GetPermissions(key, permissions) || permissions.minWritePermissionLevel > currentPermissionLevel)
+    {
+        return false;
+    }
 
-            nlohmann::json newJsonData = DataToJson(oldData);
-            return UqlJson::Get().WriteConfig(key, newJsonData);
-        }
+    // Checked again (a delete or import may have changed the permissions), the record is rebuilt from the ACL entry
+    Util::LockGuard janitor(s_aclLock);
+    auto acl = LoadAcl();
+    auto itAcl = acl->find(key);
+    if (itAcl == acl->end() || itAcl->second.minWritePermissionLevel > currentPermissionLevel)
+    {
+        return false;
+    }
+    permissions = itAcl->second;
+
+    // Only watchers need the previous data
+    auto previousRecord = IsWatched(key) ? UqlJson::Get().ReadConfigShared(key) : nullptr;
+    if (UqlJson::Get().WriteConfig(key, DataToJson({ permissions.minReadPermissionLevel, permissions.minWritePermissionLevel, permissions.minDeletePermissionLevel, data })))
+    {
+        janitor.Release();
+        NotifyWatchers(key, previousRecord ? previousRecord->at("data") : nlohmann::json(), data);
+        return true;
     }
 
     return false;
@@ -44,16 +248,12 @@ bool SCI::BAT::Config::AuthenticateConfig::WriteData(const std::string& key, int
 
 bool SCI::BAT::Config::AuthenticateConfig::ReadData(const std::string& key, int currentPermissionLevel, nlohmann::json& data)
 {
-    nlohmann::json jsonData;
-    if (UqlJson::Get().ReadConfig(key, jsonData))
+    // Reads the cached record in place (only the data section is copied)
+    auto jsonData = ReadRecord(key, currentPermissionLevel);
+    if (jsonData)
     {
-        Data ddata = JsonToData(jsonData);
-
-        if (ddata.minReadPermissionLevel <= currentPermissionLevel)
-        {
-            data = ddata.configData;
-            return true;
-        }
+        data = jsonData->at("data");
+        return true;
     }
 
     return false;
@@ -61,24 +261,41 @@ bool SCI::BAT::Config::AuthenticateConfig::ReadData(const std::string& key, int
 
 bool SCI::BAT::Config::AuthenticateConfig::DeleteData(const std::string& key, int currentPermissionLevel)
 {
-    nlohmann::json jsonData;
-    if (UqlJson::Get().ReadConfig(key, jsonData))
+    Permissions permissions;
+    if (!GetPermissions(key, permissions) || permissions.minDeletePermissionLevel > currentPermissionLevel)
     {
-        Data data = JsonToData(jsonData);
-        if (data.minDeletePermissionLevel <= currentPermissionLevel)
-        {
-            UqlJson::Get().DeleteConfig(key);
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    Util::LockGuard janitor(s_aclLock);
+    auto acl = LoadAcl();
+    auto itAcl = acl->find(key);
+    if (itAcl == acl->end() || itAcl->second.minDeletePermissionLevel > currentPermissionLevel)
+    {
+        return false;
+    }
+
+    auto previousRecord = IsWatched(key) ? UqlJson::Get().ReadConfigShared(key) : nullptr;
+    if (UqlJson::Get().DeleteConfig(key))
+    {
+        UpdateAcl([&key](AclTable& acl) { acl.erase(key); });
+        janitor.Release();
+        NotifyWatchers(key, previousRecord ? previousRecord->at("data") : nlohmann::json(), nullptr);
+    }
+    return true;
 }
 
 bool SCI::BAT::Config::AuthenticateConfig::InsertData(const std::string& key, int permissionRead, int permissionWrite, int permissionDelete, const nlohmann::json& data)
 {
-    nlohmann::json jsonData;
-    if (!UqlJson::Get().ReadConfig(key, jsonData))
+    // Existing keys are rejected without locking
+    Permissions permissions;
+    if (GetPermissions(key, permissions))
+    {
+        return false;
+    }
+
+    Util::LockGuard janitor(s_aclLock);
+    if (!LoadAcl()->contains(key))
     {
         // Describe data
         Data ddata;
@@ -87,9 +304,410 @@ bool SCI::BAT::Config::AuthenticateConfig::InsertData(const std::string& key, in
         ddata.minDeletePermissionLevel = permissionDelete;
         ddata.configData = data;
 
-        jsonData = DataToJson(ddata);
-        return UqlJson::Get().WriteConfig(key, jsonData);
+        if (UqlJson::Get().WriteConfig(key, DataToJson(ddata)))
+        {
+            UpdateAcl([&](AclTable& acl) { acl[key] = { permissionRead, permissionWrite, permissionDelete }; });
+            janitor.Release();
+            NotifyWatchers(key, nullptr, data);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SCI::BAT::Config::AuthenticateConfig::ListKeys(std::string_view prefix, int currentPermissionLevel, std::string_view after, size_t limit, std::vector<std::string>& keys)
+{
+    // Scan in chunks until the page is filled with readable keys (filtered by the ACL table, no record is read)
+    Util::Rcu::ReadGuard rcu;
+    auto acl = GetAcl();
+    keys.clear();
+    std::string cursor(after);
+    bool more = limit > 0;
+    while (more && keys.size() < limit)
+    {
+        auto chunk = UqlJson::Get().ScanPrefix(prefix, cursor, limit - keys.size(), &more);
+        if (chunk.empty())
+        {
+            break;
+        }
+
+        cursor = chunk.back();
+        for (auto& key : chunk)
+        {
+            auto itAcl = acl->find(key);
+            if (itAcl != acl->end() && itAcl->second.minReadPermissionLevel <= currentPermissionLevel)
+            {
+                keys.push_back(std::move(key));
+            }
+        }
+    }
+
+    return more;
+}
+
+size_t SCI::BAT::Config::AuthenticateConfig::ExportSnapshot(std::ostream& stream, int currentPermissionLevel)
+{
+    SCI_TRACE_SCOPE("config", "AuthenticateConfig::ExportSnapshot");
+
+    crypto_generichash_state hash;
+    crypto_generichash_init(&hash, nullptr, 0, crypto_generichash_BYTES);
+    auto write = [&](const void* data, size_t length)
+        {
+            stream.write((const char*)data, length);
+            crypto_generichash_update(&hash, (const unsigned char*)data, length);
+        };
+
+    // Records are taken from the key index in chunks (the database is never held in memory)
+    size_t count = 0;
+    write(SnapshotMagic, sizeof(SnapshotMagic));
+    std::string after;
+    bool more = true;
+    while (more)
+    {
+        auto keys = UqlJson::Get().ScanPrefix("", after, SnapshotChunkSize, &more);
+        if (keys.empty())
+        {
+            break;
+        }
+
+        after = keys.back();
+        for (const auto& key : keys)
+        {
+            auto record = ReadRecord(key, currentPermissionLevel);
+            if (record)
+            {
+                std::string data = UqlJson::Serialize(*record);
+                uint32_t keyLength = (uint32_t)key.length();
+                uint32_t dataLength = (uint32_t)data.length();
+                write(&keyLength, sizeof(keyLength));
+                write(key.data(), keyLength);
+                write(&dataLength, sizeof(dataLength));
+                write(data.data(), dataLength);
+                count++;
+            }
+        }
+    }
+
+    uint32_t end = SnapshotEnd;
+    write(&end, sizeof(end));
+    unsigned char digest[crypto_generichash_BYTES];
+    crypto_generichash_final(&hash, digest, sizeof(digest));
+    stream.write((const char*)digest, sizeof(digest));
+    stream.flush();
+
+    SCI_ASSERT(stream, "Failed to write config snapshot");
+    return count;
+}
+
+size_t SCI::BAT::Config::AuthenticateConfig::ImportSnapshot(std::istream& stream, int currentPermissionLevel, std::string& error)
+{
+    SCI_TRACE_SCOPE("config", "AuthenticateConfig::ImportSnapshot");
+
+    // Reads one record (returns false at the end marker)
+    auto start = stream.tellg();
+    crypto_generichash_state hash;
+    std::string key;
+    std::string data;
+    auto readRecord = [&](bool& ok)
+        {
+            uint32_t keyLength = 0;
+            uint32_t dataLength = 0;
+            ok = false;
+            if (!stream.read((char*)&keyLength, sizeof(keyLength)))
+                return false;
+            crypto_generichash_update(&hash, (const unsigned char*)&keyLength, sizeof(keyLength));
+            if (keyLength == SnapshotEnd)
+            {
+                ok = true;
+                return false;
+            }
+            if (keyLength > SnapshotMaxKeyLength)
+                return false;
+
+            key.resize(keyLength);
+            if (!stream.read(key.data(), keyLength) || !stream.read((char*)&dataLength, sizeof(dataLength)) || dataLength > SnapshotMaxRecordLength)
+                return false;
+            data.resize(dataLength);
+            if (!stream.read(data.data(), dataLength))
+                return false;
+
+            crypto_generichash_update(&hash, (const unsigned char*)key.data(), keyLength);
+            crypto_generichash_update(&hash, (const unsigned char*)&dataLength, sizeof(dataLength));
+            crypto_generichash_update(&hash, (const unsigned char*)data.data(), dataLength);
+            ok = true;
+            return true;
+        };
+    auto readHeader = [&]()
+        {
+            char magic[sizeof(SnapshotMagic)];
+            crypto_generichash_init(&hash, nullptr, 0, crypto_generichash_BYTES);
+            crypto_generichash_update(&hash, (const unsigned char*)SnapshotMagic, sizeof(SnapshotMagic));
+            return stream.read(magic, sizeof(magic)) && std::memcmp(magic, SnapshotMagic, sizeof(SnapshotMagic)) == 0;
+        };
+
+    // Nothing may change the permissions between the verification and the commit
+    Util::LockGuard janitor(s_aclLock);
+
+    // Pass 1: Verify everything before anything is written
+    if (!readHeader())
+    {
+        error = "not a config snapshot";
+        return 0;
+    }
+    size_t count = 0;
+    bool ok = true;
+    std::vector<std::pair<std::string, Permissions>> permissions;
+    std::vector<std::tuple<std::string, nlohmann::json, nlohmann::json>> changes;
+    while (readRecord(ok))
+    {
+        nlohmann::json record;
+        try
+        {
+            record = UqlJson::Deserialize(data.data(), data.length());
+        }
+        catch (const std::exception& ex)
+        {
+            error = fmt::format("\"{}\": {}", key, ex.what());
+            return 0;
+        }
+
+        if (!CheckSnapshotRecord(key, record, currentPermissionLevel, error))
+        {
+            error = fmt::format("\"{}\": {}", key, error);
+            return 0;
+        }
+        if (IsWatched(key))
+        {
+            auto currentRecord = UqlJson::Get().ReadConfigShared(key);
+            changes.emplace_back(key, currentRecord && !currentRecord->empty() ? currentRecord->at("data") : nlohmann::json(), record.at("data"));
+        }
+        permissions.emplace_back(key, RecordPermissions(record));
+        count++;
+    }
+    unsigned char digest[crypto_generichash_BYTES];
+    unsigned char expectedDigest[crypto_generichash_BYTES];
+    crypto_generichash_final(&hash, digest, sizeof(digest));
+    if (!ok || !stream.read((char*)expectedDigest, sizeof(expectedDigest)))
+    {
+        error = "snapshot is truncated or corrupted";
+        return 0;
+    }
+    if (sodium_memcmp(digest, expectedDigest, sizeof(digest)) != 0)
+    {
+        error = "checksum mismatch";
+        return 0;
+    }
+
+    // Pass 2: Write in one transaction
+    stream.clear();
+    stream.seekg(start);
+    SCI_ASSERT(readHeader(), "Config snapshot changed while importing");
+    bool committed = UqlJson::Get().WriteStream([&](std::string& recordKey, std::string& record)
+        {
+            bool next = readRecord(ok);
+            SCI_ASSERT(ok, "Config snapshot changed while importing");
+            if (next)
+            {
+                recordKey = key;
+                record = data;
+            }
+            return next;
+        });
+    if (!committed)
+    {
+        error = "failed to commit the snapshot";
+        return 0;
+    }
+    UpdateAcl([&permissions](AclTable& acl)
+        {
+            for (auto& [importedKey, importedPermissions] : permissions)
+            {
+                acl[std::move(importedKey)] = importedPermissions;
+            }
+        });
+    janitor.Release();
+
+    for (const auto& [changedKey, oldData, newData] : changes)
+    {
+        NotifyWatchers(changedKey, oldData, newData);
+    }
+    return count;
+}
+
+uint64_t SCI::BAT::Config::AuthenticateConfig::Watch(std::string key, WatchCallback callback)
+{
+    Util::LockGuard janitor(s_watchersLock);
+    uint64_t id = s_nextWatchId++;
+    s_watchers.push_back({ id, std::move(key), std::move(callback) });
+    return id;
+}
+
+void SCI::BAT::Config::AuthenticateConfig::Unwatch(uint64_t id)
+{
+    Util::LockGuard janitor(s_watchersLock);
+    std::erase_if(s_watchers, [id](const Watcher& watcher) { return watcher.id == id; });
+}
+
+void SCI::BAT::Config::AuthenticateConfig::RegisterValidator(const std::string& key, Validator validator)
+{
+    Util::LockGuard janitor(s_validatorsLock);
+    s_validators[key] = validator;
+}
+
+bool SCI::BAT::Config::AuthenticateConfig::Validate(const std::string& key, const nlohmann::json& data, std::string& error)
+{
+    Validator validator = nullptr;
+    {
+        Util::SharedLockGuard janitor(s_validatorsLock);
+        auto itValidator = s_validators.find(key);
+        if (itValidator != s_validators.end())
+        {
+            validator = itValidator->second;
+        }
+    }
+
+    return !validator || validator(data, error);
+}
+
+bool SCI::BAT::Config::AuthenticateConfig::GetPermissions(const std::string& key, Permissions& permissions)
+{
+    Util::Rcu::ReadGuard rcu;
+    auto acl = GetAcl();
+    auto itAcl = acl->find(key);
+    if (itAcl != acl->end())
+    {
+        permissions = itAcl->second;
+        return true;
+    }
+    return false;
+}
+
+std::shared_ptr<const nlohmann::json> SCI::BAT::Config::AuthenticateConfig::ReadRecord(const std::string& key, int currentPermissionLevel)
+{
+    Permissions permissions;
+    if (!GetPermissions(key, permissions) || permissions.minReadPermissionLevel > currentPermissionLevel)
+    {
+        return nullptr;
+    }
+
+    auto jsonData = UqlJson::Get().ReadConfigShared(key);
+    return jsonData && !jsonData->empty() ? jsonData : nullptr;
+}
+
+void SCI::BAT::Config::AuthenticateConfig::NotifyWatchers(const std::string& key, const nlohmann::json& oldData, const nlohmann::json& newData)
+{
+    // Rewriting the same data is no change
+    if (oldData == newData)
+    {
+        return;
     }
 
+    Util::SharedLockGuard janitor(s_watchersLock);
+    for (const auto& watcher : s_watchers)
+    {
+        if (key.starts_with(watcher.key) && (key.length() == watcher.key.length() || key[watcher.key.length()] == '.'))
+        {
+            watcher.callback(key, oldData, newData);
+        }
+    }
+}
+
+bool SCI::BAT::Config::AuthenticateConfig::IsWatched(const std::string& key)
+{
+    Util::SharedLockGuard janitor(s_watchersLock);
+    for (const auto& watcher : s_watchers)
+    {
+        if (key.starts_with(watcher.key) && (key.length() == watcher.key.length() || key[watcher.key.length()] == '.'))
+        {
+            return true;
+        }
+    }
     return false;
 }
+
+bool SCI::BAT::Config::AuthenticateConfig::CheckSnapshotRecord(const std::string& key, const nlohmann::json& record, int currentPermissionLevel, std::string& error)
+{
+    // Structure of a stored record
+    if (!record.is_object() || !record.contains("data") || !record.contains("permission") || !record["permission"].is_object())
+    {
+        error = "invalid record";
+        return false;
+    }
+    const auto& permission = record["permission"];
+    for (const char* level : { "read", "write", "delete" })
+    {
+        if (!permission.contains(level) || !permission[level].is_number_integer())
+        {
+            error = fmt::format("invalid {} permission", level);
+            return false;
+        }
+    }
+
+    if (!Validate(key, record["data"], error))
+    {
+        return false;
+    }
+
+    // Nobody can grant more than the own write permission
+    if (permission["write"].get<int>() > currentPermissionLevel)
+    {
+        error = "permission denied";
+        return false;
+    }
+    auto acl = LoadAcl();
+    auto itAcl = acl->find(key);
+    if (itAcl != acl->end() && itAcl->second.minWritePermissionLevel > currentPermissionLevel)
+    {
+        error = "permission denied";
+        return false;
+    }
+    return true;
+}
+
+const SCI::BAT::Config::AuthenticateConfig::AclTable* SCI::BAT::Config::AuthenticateConfig::GetAcl()
+{
+    auto acl = s_acl.Load();
+    if (!acl)
+    {
+        Util::LockGuard janitor(s_aclLock);
+        acl = LoadAcl();
+    }
+    return acl;
+}
+
+const SCI::BAT::Config::AuthenticateConfig::AclTable* SCI::BAT::Config::AuthenticateConfig::LoadAcl()
+{
+    auto acl = s_acl.Load();
+    if (!acl)
+    {
+        // First use: One pass over all records (later changes only update the table)
+        auto table = std::make_unique<AclTable>();
+        for (auto& key : UqlJson::Get().ScanPrefix("", "", std::numeric_limits<size_t>::max()))
+        {
+            auto record = UqlJson::Get().ReadConfigShared(key);
+            if (record && !record->empty())
+            {
+                table->emplace(std::move(key), RecordPermissions(*record));
+            }
+        }
+
+        acl = table.release();
+        s_acl.Store(acl);
+    }
+    return acl;
+}
+
+void SCI::BAT::Config::AuthenticateConfig::UpdateAcl(const std::function<void(AclTable& acl)>& update)
+{
+    // Copy on write: Readers keep the table they loaded, it is deleted after their read sections ended
+    auto acl = std::make_unique<AclTable>(*LoadAcl());
+    update(*acl);
+    s_acl.Store(acl.release());
+}
+
+SCI::BAT::Config::AuthenticateConfig::Permissions SCI::BAT::Config::AuthenticateConfig::RecordPermissions(const nlohmann::json& record)
+{
+    const auto& permission = record.at("permission");
+    return { permission.at("read").get<int>(), permission.at("write").get<int>(), permission.at("delete").get<int>() };
+}
@@ -6,10 +6,26 @@
 #pragma once
 
 #include <Config/UqlJson.h>
+#include <Config/Schema.h>
+
+#include <SCIUtil/Concurrent/AdaptiveLock.h>
+#include <SCIUtil/Concurrent/SharedSpinLock.h>
+#include <SCIUtil/Concurrent/SharedLockGuard.h>
+#include <SCIUtil/Concurrent/LockGuard.h>
+#include <SCIUtil/Concurrent/Rcu.h>
 
 #include <nlohmann/json.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace SCI::BAT::Config
 {
@@ -31,6 +47,132 @@ namespace SCI::BAT::Config
                 nlohmann::json configData;
             };
 
+            /*!
+             * @brief Permission levels of a setting (entry of the ACL table).
+            */
+            struct Permissions
+            {
+                int minReadPermissionLevel = -1;
+                int minWritePermissionLevel = -1;
+                int minDeletePermissionLevel = -1;
+            };
+
+            /*!
+             * @brief Checks the data of a setting. Returns false and describes the problem in error if the data is invalid.
+            */
+            using Validator = bool(*)(const nlohmann::json& data, std::string& error);
+            /*!
+             * @brief Receives changes of watched settings (key, data before and data after the change; null if the setting did not / does not exist).
+            */
+            using WatchCallback = std::function<void(const std::string& key, const nlohmann::json& oldData, const nlohmann::json& newData)>;
+
+            /*!
+             * @brief Groups writes, inserts and deletes of multiple settings into one atomic database commit.
+             *
+             * Permissions and schemas are checked when an operation is staged. Nothing is written before Commit(), which checks the permissions
+             * again (settings may have been deleted or imported since staging).
+            */
+            class Transaction
+            {
+                public:
+                    /*!
+                     * @brief Outcome of Commit()
+                    */
+                    enum class CommitResult
+                    {
+                        /*! All operations were applied */
+                        Committed,
+                        /*! The permissions of a setting changed since staging and no longer allow the operation */
+                        Denied,
+                        /*! A setting was deleted or inserted since staging */
+                        Conflict,
+                        /*! The database commit failed */
+                        Failed,
+                    };
+
+                public:
+                    /*!
+                     * @brief Starts an empty transaction.
+                     * @param currentPermissionLevel The current users permission level (applies to all operations).
+                    */
+                    Transaction(int currentPermissionLevel);
+
+                    /*!
+                     * @brief Stages a write of an existing setting (see WriteData).
+                     * @param key The key to which the write shall occur. The key must exist or be inserted earlier in the transaction.
+                     * @param data Data to write.
+                     * @return True if the write was staged. False if the key did not exists, the user had insufficient permission or the data is invalid.
+                    */
+                    bool Write(const std::string& key, const nlohmann::json& data);
+                    /*!
+                     * @brief Stages the insertion of a new setting (see InsertData).
+                     * @param key Name of the setting to be inserted. The key must not exists.
+                     * @param permissionRead Read permission level of the new setting.
+                     * @param permissionWrite Write permission level of the new setting.
+                     * @param permissionDelete Delete permission level of the new setting.
+                     * @param data Data to be inserted.
+                     * @return True if the insertion was staged.
+                    */
+                    bool Insert(const std::string& key, int permissionRead, int permissionWrite, int permissionDelete, const nlohmann::json& data);
+                    /*!
+                     * @brief Stages the insertion of the defaults of the config struct if the setting does not exist (the schema is registered by RegisterSchema()).
+                     * @tparam S Config struct (see Schema).
+                     * @param key Name of the setting.
+                     * @param permissionRead Read permission level of the new setting.
+                     * @param permissionWrite Write permission level of the new setting.
+                     * @param permissionDelete Delete permission level of the new setting.
+                     * @return True if the insertion was staged.
+                    */
+                    template<typename S>
+                    inline bool InsertDefaults(const std::string& key, int permissionRead, int permissionWrite, int permissionDelete)
+                    {
+                        return Insert(key, permissionRead, permissionWrite, permissionDelete, Schema<S>::ToJson(S{}));
+                    }
+                    /*!
+                     * @brief Stages the deletion of a setting (see DeleteData).
+                     * @param key The key that should be deleted. The key must exist.
+                     * @return True if the deletion was staged.
+                    */
+                    bool Delete(const std::string& key);
+
+                    /*!
+                     * @brief Applies all staged operations in one commit. Written records take the current permissions of the setting.
+                     * @return Committed if all operations were applied. Nothing is changed otherwise (the result tells why).
+                    */
+                    CommitResult Commit();
+
+                    /*!
+                     * @brief Retrieves the keys changed by the transaction (in order of staging, may contain duplicates).
+                     * @return Vector of keys
+                    */
+                    std::vector<std::string> GetKeys() const;
+
+                private:
+                    /*!
+                     * @brief Looks up the current permissions of a key (staged operations first, then the ACL table).
+                     * @param key Name of the setting.
+                     * @param permissions Receives the permission levels.
+                     * @return True if the key exists.
+                    */
+                    bool GetStagedPermissions(const std::string& key, Permissions& permissions) const;
+
+                private:
+                    /*!
+                     * @brief Kind of a staged operation (checked again by Commit())
+                    */
+                    enum class OperationType
+                    {
+                        Write,
+                        Insert,
+                        Delete,
+                    };
+
+                private:
+                    int m_permissionLevel;
+                    std::vector<UqlJson::BatchOperation> m_operations;
+                    std::vector<OperationType> m_types;
+            };
+
         public:
             AuthenticateConfig() = delete;
             AuthenticateConfig(const AuthenticateConfig&) = delete;
@@ -54,7 +196,7 @@ namespace SCI::BAT::Config
              * @param key The key to which the write shall occur. The key must exist.
              * @param currentPermissionLevel The current users permission level. User needs to be allowed to write or the function will fail.
              * @param data Data to wire to the with key specified setting.
-             * @return True if data was written. False if the key did not exists or the user had insufficient permission.
+             * @return True if data was written. False if the key did not exists, the user had insufficient permission or the data does not match the schema of the key.
             */
             static bool WriteData(const std::string& key, int currentPermissionLevel, const nlohmann::json& data);
             /*!
@@ -82,5 +224,204 @@ namespace SCI::BAT::Config
              * @return True if setting was inserted successfully.
             */
             static bool InsertData(const std::string& key, int permissionRead, int permissionWrite, int permissionDelete, const nlohmann::json& data);
+            /*!
+             * @brief Lists the settings starting with a prefix that the user is allowed to read (ascending, paged).
+             * @param prefix Common prefix of the keys ("user." lists all users).
+             * @param currentPermissionLevel The current users permission level. Settings the user can't read are skipped.
+             * @param after Last key of the previous page (empty for the first page).
+             * @param limit Maximum number of keys.
+             * @param keys Receives the keys.
+             * @return True if more keys follow.
+            */
+            static bool ListKeys(std::string_view prefix, int currentPermissionLevel, std::string_view after, size_t limit, std::vector<std::string>& keys);
+
+            /*!
+             * @brief Registers the validator of a setting. Writes that fail validation are rejected.
+             * @param key Name of the setting.
+             * @param validator Validator function.
+            */
+            static void RegisterValidator(const std::string& key, Validator validator);
+            /*!
+             * @brief Validates data against the registered validator of a setting.
+             * @param key Name of the setting.
+             * @param data Data to validate.
+             * @param error Receives the reason if the data is invalid.
+             * @return True if the data is valid or the setting has no validator.
+            */
+            static bool Validate(const std::string& key, const nlohmann::json& data, std::string& error);
+
+            /*!
+             * @brief Looks up the permission levels of a setting in the ACL table (lock free, no database access).
+             * @param key Name of the setting.
+             * @param permissions Receives the permission levels.
+             * @return True if the setting exists.
+            */
+            static bool GetPermissions(const std::string& key, Permissions& permissions);
+
+            /*!
+             * @brief Writes all settings the user can read as a snapshot (streamed, keys in ascending order).
+             * 
+             * Layout (host byte order): 8 byte magic "SCICONF1", records of { u32 key length, key, u32 record length, record (on disk format, includes the permissions) },
+             * u32 0xFFFFFFFF, 32 byte BLAKE2b hash (crypto_generichash) of everything before the hash.
+             * @param stream Binary output stream.
+             * @param currentPermissionLevel The current users permission level. Settings the user can't read are skipped.
+             * @return Number of exported settings.
+            */
+            static size_t ExportSnapshot(std::ostream& stream, int currentPermissionLevel);
+            /*!
+             * @brief Imports a snapshot atomically (all settings or none).
+             * 
+             * The stream is read twice: The first pass verifies the checksum, the records, the schemas and the permissions, the second pass
+             * writes the settings in one transaction. Only one record is held in memory at a time.
+             * @param stream Seekable binary input stream (positioned at the snapshot).
+             * @param currentPermissionLevel The current users permission level. Existing settings need write permission, new settings can't be
+             * less restricted for writing than the user.
+             * @param error Receives the reason if the import fails.
+             * @return Number of imported settings (0 on failure).
+            */
+            static size_t ImportSnapshot(std::istream& stream, int currentPermissionLevel, std::string& error);
+
+            /*!
+             * @brief Subscribes to changes of a setting.
+             * 
+             * The callback is invoked on the writing thread after the change was stored. It should only hand the change over
+             * to the watching module (keep it short) and must not call Watch() or Unwatch().
+             * @param key Watched key (also matches all child keys separated by a dot, "user" watches "user.admin").
+             * @param callback Callback receiving the changes.
+             * @return Id of the subscription (for Unwatch()).
+            */
+            static uint64_t Watch(std::string key, WatchCallback callback);
+            /*!
+             * @brief Ends a subscription. Waits for running invocations of the callback.
+             * @param id Id returned by Watch().
+            */
+            static void Unwatch(uint64_t id);
+
+            /*!
+             * @brief Registers the schema of a typed config struct as validator of a setting.
+             * @tparam S Config struct (see Schema).
+             * @param key Name of the setting.
+            */
+            template<typename S>
+            static inline void RegisterSchema(const std::string& key)
+            {
+                RegisterValidator(key, &Schema<S>::Validate);
+            }
+            /*!
+             * @brief Reads a setting into a typed config struct (decoded from the cached record without copying it).
+             * @tparam S Config struct (see Schema).
+             * @param key The key to which the read shall occur. The key must exist.
+             * @param currentPermissionLevel The current users permission level. User needs to be allowed to read or the function will fail.
+             * @param value Receives the values. Left untouched if the read fails.
+             * @param error Receives the reason if the read fails.
+             * @return True if the setting was read and is valid.
+            */
+            template<typename S>
+            static bool ReadTyped(const std::string& key, int currentPermissionLevel, S& value, std::string& error)
+            {
+                auto record = ReadRecord(key, currentPermissionLevel);
+                if (!record)
+                {
+                    error = "setting does not exist or permission denied";
+                    return false;
+                }
+                return Schema<S>::FromJson(record->at("data"), value, error);
+            }
+
+        private:
+            /*!
+             * @brief Permissions of all settings (never modified once published).
+            */
+            using AclTable = std::unordered_map<std::string, Permissions>;
+
+            /*!
+             * @brief Reads the cached record of a setting if the user is allowed to read it (denied without database access).
+             * @param key Name of the setting.
+             * @param currentPermissionLevel The current users permission level.
+             * @return Record or nullptr.
+            */
+            static std::shared_ptr<const nlohmann::json> ReadRecord(const std::string& key, int currentPermissionLevel);
+            /*!
+             * @brief Reports a stored change to all watchers of the key.
+             * @param key Changed setting.
+             * @param oldData Data before the change (null if inserted).
+             * @param newData Data after the change (null if deleted).
+            */
+            static void NotifyWatchers(const std::string& key, const nlohmann::json& oldData, const nlohmann::json& newData);
+            /*!
+             * @brief Checks if a change of the key would be reported to a watcher.
+             * @param key Name of the setting.
+             * @return True if watched.
+            */
+            static bool IsWatched(const std::string& key);
+            /*!
+             * @brief Checks a record of a snapshot before it is imported.
+             * @param key Name of the setting.
+             * @param record Decoded record.
+             * @param currentPermissionLevel The importing users permission level.
+             * @param oldData Receives the current data of the setting (null if it does not exist).
+             * @param error Receives the reason if the record can't be imported.
+             * @return True if the record can be imported.
+            */
+            static bool CheckSnapshotRecord(const std::string& key, const nlohmann::json& record, int currentPermissionLevel, std::string& error);
+
+            /*!
+             * @brief Retrives the current ACL table (caller holds a Util::Rcu::ReadGuard). Builds the table from the database on first use.
+             * @return Immutable table (valid until the guard is released).
+            */
+            static const AclTable* GetAcl();
+            /*!
+             * @brief Retrives the current ACL table (caller holds s_aclLock).
+             * @return Immutable table (valid until the next UpdateAcl()).
+            */
+            static const AclTable* LoadAcl();
+            /*!
+             * @brief Publishes a modified copy of the ACL table (caller holds s_aclLock).
+             * @param update Modifies the copy.
+            */
+            static void UpdateAcl(const std::function<void(AclTable& acl)>& update);
+            /*!
+             * @brief Extracts the permission levels of a record.
+             * @param record Stored record.
+             * @return Permission levels.
+            */
+            static Permissions RecordPermissions(const nlohmann::json& record);
+
+        private:
+            /*! Snapshot file magic (includes the format version) */
+            static constexpr char SnapshotMagic[8] = { 'S', 'C', 'I', 'C', 'O', 'N', 'F', '1' };
+            /*! Key length marking the end of the records */
+            static constexpr uint32_t SnapshotEnd = 0xFFFFFFFF;
+            /*! Longest key accepted on import */
+            static constexpr uint32_t SnapshotMaxKeyLength = 4096;
+            /*! Largest record accepted on import */
+            static constexpr uint32_t SnapshotMaxRecordLength = 64 * 1024 * 1024;
+            /*! Keys read from the index per export step */
+            static constexpr size_t SnapshotChunkSize = 256;
+
+        private:
+            /*!
+             * @brief Subscription of a key.
+            */
+            struct Watcher
+            {
+                uint64_t id;
+                std::string key;
+                WatchCallback callback;
+            };
+
+        private:
+            // Permissions of all settings. Readers load the table inside a read section (no lock, no shared write), writers hold
+            // s_aclLock while they change the database and publish a modified copy (the table mirrors the order of the database)
+            static Util::AdaptiveLock s_aclLock;
+            static Util::RcuPointer<AclTable> s_acl;
+
+            static Util::SharedSpinLock s_validatorsLock;
+            static std::unordered_map<std::string, Validator> s_validators;
+
+            // Held shared while callbacks run, Unwatch() waits for them
+            static Util::SharedSpinLock s_watchersLock;
+            static std::vector<Watcher> s_watchers;
+            static uint64_t s_nextWatchId;
     };
 }
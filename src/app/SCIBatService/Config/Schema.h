@@ -0,0 +1,361 @@
+/*!
+ * @file Schema.h
+ * @brief Compile time description of typed config structs (validation, serialization and deserialization).
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace SCI::BAT::Config
+{
+    /*!
+     * @brief Binds a member of a config struct to a (dotted) json path.
+     * @tparam S Config struct
+     * @tparam T Type of the member
+    */
+    template<typename S, typename T>
+    struct Field
+    {
+        /*! Path in the json document ("broker.port") */
+        std::string_view path;
+        /*! Member in the struct */
+        T S::* member;
+        /*! Smallest valid value (numbers, durations and the values of containers) */
+        double min = -std::numeric_limits<double>::infinity();
+        /*! Largest valid value (numbers, durations and the values of containers) */
+        double max = std::numeric_limits<double>::infinity();
+    };
+
+    /*!
+     * @brief Describes a field without range check
+     * @param path Dotted json path
+     * @param member Pointer to the member
+     * @return Field descriptor
+    */
+    template<typename S, typename T>
+    constexpr Field<S, T> MakeField(std::string_view path, T S::* member)
+    {
+        return { path, member };
+    }
+    /*!
+     * @brief Describes a field with range check (inclusive)
+     * @param path Dotted json path
+     * @param member Pointer to the member
+     * @param min Smallest valid value
+     * @param max Largest valid value
+     * @return Field descriptor
+    */
+    template<typename S, typename T>
+    constexpr Field<S, T> MakeField(std::string_view path, T S::* member, double min, double max)
+    {
+        return { path, member, min, max };
+    }
+
+    /*!
+     * @brief Conversion of a single value type.
+     *
+     * Supported: bool, integers, floating point, std::string, std::chrono::duration (stored as count of its unit), std::vector<T> and std::map<std::string, T>.
+     * @tparam T Value type
+    */
+    template<typename T, typename = void>
+    struct SchemaValue;
+
+    template<>
+    struct SchemaValue<bool>
+    {
+        static constexpr std::string_view TypeName = "boolean";
+        static bool Decode(const nlohmann::json& json, bool& value, double, double, std::string&)
+        {
+            if (!json.is_boolean())
+                return false;
+            value = json.get<bool>();
+            return true;
+        }
+        static nlohmann::json Encode(bool value) { return value; }
+    };
+
+    template<typename T>
+    struct SchemaValue<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    {
+        static constexpr std::string_view TypeName = "integer";
+        static bool Decode(const nlohmann::json& json, T& value, double min, double max, std::string& error)
+        {
+            if (!json.is_number_integer())
+                return false;
+
+            // Values that do not fit the member are range errors (no silent wrap around)
+            double number = json.is_number_unsigned() ? (double)json.get<uint64_t>() : (double)json.get<int64_t>();
+            min = std::max(min, (double)std::numeric_limits<T>::min());
+            max = std::min(max, (double)std::numeric_limits<T>::max());
+            if (number < min || number > max)
+            {
+                error = fmt::format("{} is out of range [{}, {}]", number, min, max);
+                return false;
+            }
+            value = json.get<T>();
+            return true;
+        }
+        static nlohmann::json Encode(T value) { return value; }
+    };
+
+    template<typename T>
+    struct SchemaValue<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    {
+        static constexpr std::string_view TypeName = "number";
+        static bool Decode(const nlohmann::json& json, T& value, double min, double max, std::string& error)
+        {
+            if (!json.is_number())
+                return false;
+            double number = json.get<double>();
+            if (number < min || number > max)
+            {
+                error = fmt::format("{} is out of range [{}, {}]", number, min, max);
+                return false;
+            }
+            value = (T)number;
+            return true;
+        }
+        static nlohmann::json Encode(T value) { return value; }
+    };
+
+    template<>
+    struct SchemaValue<std::string>
+    {
+        static constexpr std::string_view TypeName = "string";
+        static bool Decode(const nlohmann::json& json, std::string& value, double, double, std::string&)
+        {
+            if (!json.is_string())
+                return false;
+            value = json.get_ref<const std::string&>();
+            return true;
+        }
+        static nlohmann::json Encode(const std::string& value) { return value; }
+    };
+
+    template<typename Rep, typename Period>
+    struct SchemaValue<std::chrono::duration<Rep, Period>>
+    {
+        static constexpr std::string_view TypeName = "integer";
+        static bool Decode(const nlohmann::json& json, std::chrono::duration<Rep, Period>& value, double min, double max, std::string& error)
+        {
+            Rep count;
+            if (!SchemaValue<Rep>::Decode(json, count, min, max, error))
+                return false;
+            value = std::chrono::duration<Rep, Period>(count);
+            return true;
+        }
+        static nlohmann::json Encode(const std::chrono::duration<Rep, Period>& value) { return value.count(); }
+    };
+
+    template<typename T>
+    struct SchemaValue<std::vector<T>>
+    {
+        static constexpr std::string_view TypeName = "array";
+        static bool Decode(const nlohmann::json& json, std::vector<T>& value, double min, double max, std::string& error)
+        {
+            if (!json.is_array())
+                return false;
+
+            std::vector<T> elements(json.size());
+            for (size_t i = 0; i < json.size(); i++)
+            {
+                if (!SchemaValue<T>::Decode(json[i], elements[i], min, max, error))
+                {
+                    error = fmt::format("[{}]: {}", i, error.empty() ? fmt::format("expected {}", SchemaValue<T>::TypeName) : error);
+                    return false;
+                }
+            }
+            value = std::move(elements);
+            return true;
+        }
+        static nlohmann::json Encode(const std::vector<T>& value)
+        {
+            nlohmann::json json = nlohmann::json::array();
+            for (const auto& element : value)
+                json.push_back(SchemaValue<T>::Encode(element));
+            return json;
+        }
+    };
+
+    template<typename T>
+    struct SchemaValue<std::map<std::string, T>>
+    {
+        static constexpr std::string_view TypeName = "object";
+        static bool Decode(const nlohmann::json& json, std::map<std::string, T>& value, double min, double max, std::string& error)
+        {
+            if (!json.is_object())
+                return false;
+
+            std::map<std::string, T> elements;
+            for (const auto& [key, element] : json.items())
+            {
+                if (!SchemaValue<T>::Decode(element, elements[key], min, max, error))
+                {
+                    error = fmt::format("[\"{}\"]: {}", key, error.empty() ? fmt::format("expected {}", SchemaValue<T>::TypeName) : error);
+                    return false;
+                }
+            }
+            value = std::move(elements);
+            return true;
+        }
+        static nlohmann::json Encode(const std::map<std::string, T>& value)
+        {
+            nlohmann::json json = nlohmann::json::object();
+            for (const auto& [key, element] : value)
+                json[key] = SchemaValue<T>::Encode(element);
+            return json;
+        }
+    };
+
+    /*!
+     * @brief Typed access to config structs.
+     *
+     * A config struct lists its fields in a static constexpr tuple named Fields:
+     * @code
+     * struct TControlConfig
+     * {
+     *     std::string device = "/dev/tty";
+     *     unsigned int cooloffTime = 5000;
+     *
+     *     static constexpr auto Fields = std::make_tuple(
+     *         Config::MakeField("serial.device", &TControlConfig::device),
+     *         Config::MakeField("cooloff-time", &TControlConfig::cooloffTime, 0, 3600000)
+     *     );
+     * };
+     * @endcode
+     * Member initializers are the defaults. Fields missing in the json keep their default, unknown json values are ignored.
+     * Constraints between fields go into an optional static function "static bool Check(const S& value, std::string& error)".
+     * @tparam S Config struct
+    */
+    template<typename S>
+    class Schema
+    {
+        public:
+            /*!
+             * @brief Serializes a config struct
+             * @param value Config struct
+             * @return Json document
+            */
+            static nlohmann::json ToJson(const S& value)
+            {
+                nlohmann::json json = nlohmann::json::object();
+                std::apply([&](const auto&... fields) { (EncodeField(json, value, fields), ...); }, S::Fields);
+                return json;
+            }
+
+            /*!
+             * @brief Deserializes and validates a config struct. Nothing is assigned when a field is invalid.
+             * @param json Json document
+             * @param value Struct receiving the values
+             * @param error Receives the invalid field and the reason
+             * @return True if all fields are valid
+            */
+            static bool FromJson(const nlohmann::json& json, S& value, std::string& error)
+            {
+                if (!json.is_object())
+                {
+                    error = "expected object";
+                    return false;
+                }
+
+                S decoded = value;
+                bool valid = std::apply([&](const auto&... fields) { return (DecodeField(json, decoded, fields, error) && ...); }, S::Fields);
+                if constexpr (requires(const S& checked, std::string& reason) { { S::Check(checked, reason) } -> std::convertible_to<bool>; })
+                {
+                    valid = valid && S::Check(decoded, error);
+                }
+                if (valid)
+                {
+                    value = std::move(decoded);
+                }
+                return valid;
+            }
+
+            /*!
+             * @brief Validates a json document against the schema
+             * @param json Json document
+             * @param error Receives the invalid field and the reason
+             * @return True if the document is valid
+            */
+            static bool Validate(const nlohmann::json& json, std::string& error)
+            {
+                S value;
+                return FromJson(json, value, error);
+            }
+
+            /*!
+             * @brief Compares the fields below a path (used to decide what a config change affects)
+             * @param lhs First config
+             * @param rhs Second config
+             * @param path Dotted path of a field or a parent object ("broker" covers "broker.port"). Empty compares all fields.
+             * @return True if at least one of the fields differs
+            */
+            static bool Differs(const S& lhs, const S& rhs, std::string_view path = "")
+            {
+                return std::apply([&](const auto&... fields) { return (FieldDiffers(lhs, rhs, fields, path) || ...); }, S::Fields);
+            }
+
+        private:
+            template<typename T>
+            static bool FieldDiffers(const S& lhs, const S& rhs, const Field<S, T>& field, std::string_view path)
+            {
+                bool covered = path.empty() || (field.path.starts_with(path) && (field.path.length() == path.length() || field.path[path.length()] == '.'));
+                return covered && !(lhs.*field.member == rhs.*field.member);
+            }
+
+            template<typename T>
+            static void EncodeField(nlohmann::json& json, const S& value, const Field<S, T>& field)
+            {
+                // Create the parent objects of the path
+                nlohmann::json* node = &json;
+                std::string_view path = field.path;
+                for (size_t dot = path.find('.'); dot != std::string_view::npos; dot = path.find('.'))
+                {
+                    node = &(*node)[std::string(path.substr(0, dot))];
+                    path.remove_prefix(dot + 1);
+                }
+                (*node)[std::string(path)] = SchemaValue<T>::Encode(value.*field.member);
+            }
+
+            template<typename T>
+            static bool DecodeField(const nlohmann::json& json, S& value, const Field<S, T>& field, std::string& error)
+            {
+                // Walk the path (a missing node keeps the default)
+                const nlohmann::json* node = &json;
+                std::string_view path = field.path;
+                while (!path.empty())
+                {
+                    size_t dot = path.find('.');
+                    auto segment = path.substr(0, dot);
+                    if (!node->is_object())
+                        return true;
+                    auto itNode = node->find(segment);
+                    if (itNode == node->end())
+                        return true;
+                    node = &*itNode;
+                    path.remove_prefix(dot == std::string_view::npos ? path.length() : dot + 1);
+                }
+
+                std::string reason;
+                if (!SchemaValue<T>::Decode(*node, value.*field.member, field.min, field.max, reason))
+                {
+                    error = fmt::format("\"{}\": {}", field.path, reason.empty() ? fmt::format("expected {}", SchemaValue<T>::TypeName) : reason);
+                    return false;
+                }
+                return true;
+            }
+    };
+}
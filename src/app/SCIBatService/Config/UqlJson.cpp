@@ -1,11 +1,17 @@
 #include "UqlJson.h"
 
+#include <cstring>
+#include <utility>
+#include <vector>
+
 SCI::BAT::Config::UqlJson SCI::BAT::Config::UqlJson::s_instance;
 
 SCI::BAT::Config::UqlJson::~UqlJson()
 {
     if (m_db)
     {
+        // Last checkpoint (the module threads are stopped)
+        CommitPending();
         unqlite_close(m_db);
     }
 }
@@ -14,45 +20,466 @@ void SCI::BAT::Config::UqlJson::Init(const std::filesystem::path& dbFile)
 {
     int rc = unqlite_open(&m_db, dbFile.generic_string().c_str(), UNQLITE_OPEN_CREATE);
     SCI_ASSERT_FMT(rc == UNQLITE_OK, "Failed to opern config datable \"{}\" (Error code {})", dbFile.generic_string(), rc);
+
+    // Databases of older versions store text JSON
+    MigrateTextRecords();
+
+    Util::LockGuard janitor(m_lock);
+    RebuildKeyIndex();
+}
+
+void SCI::BAT::Config::UqlJson::SetDurability(Durability durability, size_t maxPending /*= 256*/)
+{
+    SCI_ASSERT(!m_db, "Durability must be set before the config database is initialized");
+    SCI_ASSERT(maxPending > 0, "At least one write must be stageable");
+
+    m_durability = durability;
+    m_maxPending = maxPending;
+}
+
+bool SCI::BAT::Config::UqlJson::Checkpoint()
+{
+    SCI_TRACE_SCOPE("config", "UqlJson::Checkpoint");
+    SCI_ASSERT(m_db, "Config database not initialized");
+
+    Util::LockGuard janitor(m_lock);
+    return CommitPending();
+}
+
+SCI::BAT::Config::UqlJson::Stats SCI::BAT::Config::UqlJson::GetStats() const
+{
+    Util::LockGuard janitor(m_lock);
+    Stats stats = m_stats;
+    stats.pending = m_pending.size();
+    return stats;
 }
 
 bool SCI::BAT::Config::UqlJson::ReadConfig(const std::string& key, nlohmann::json& jsonOut) const
 {
+    auto value = ReadConfigShared(key);
+    if (value)
+    {
+        jsonOut = *value;
+        return !jsonOut.empty();
+    }
+    return false;
+}
+
+std::shared_ptr<const nlohmann::json> SCI::BAT::Config::UqlJson::ReadConfigShared(const std::string& key) const
+{
+    SCI_TRACE_SCOPE("config", "UqlJson::ReadConfig");
     SCI_ASSERT(m_db, "Config database not initialized");
 
+    // Cached
+    Util::SharedLockGuard cacheJanitor(m_cacheLock);
+    auto itCache = m_cache.find(key);
+    if (itCache != m_cache.end())
+    {
+        return itCache->second;
+    }
+    cacheJanitor.Release();
 
-    Util::LockGuard janitor(m_lock); // Begin critical section
+    // Only the database access is serialized (the handle is not safe for concurrent use). Parsing happens outside the lock
+    CacheEntry value;
+    std::string jsonData;
     unqlite_int64 dataLen = 0;
+    Util::LockGuard janitor(m_lock); // Begin critical section
     if (unqlite_kv_fetch(m_db, key.c_str(), key.length(), nullptr, &dataLen) == UNQLITE_OK)
     {
-        std::string jsonData;
         jsonData.resize(dataLen + 1);
-        
-        if (unqlite_kv_fetch(m_db, key.c_str(), key.length(), jsonData.data(), &dataLen) == UNQLITE_OK)
+        if (unqlite_kv_fetch(m_db, key.c_str(), key.length(), jsonData.data(), &dataLen) != UNQLITE_OK)
         {
-            jsonOut = nlohmann::json::parse(jsonData);
-            return !jsonOut.empty();
+            // Not cached (the read may succeed next time)
+            return nullptr;
         }
     }
+    janitor.Release(); // End critical section
 
-    return false;
+    if (!jsonData.empty())
+    {
+        SCI_TRACE_SCOPE("config", "UqlJson::Parse");
+        value = std::make_shared<const nlohmann::json>(Deserialize(jsonData.data(), (size_t)dataLen));
+    }
+
+    // A write or delete that happened since the fetch already stored the newer value. It must not be replaced
+    Util::LockGuard cacheWriteJanitor(m_cacheLock);
+    return m_cache.try_emplace(key, std::move(value)).first->second;
 }
 
 bool SCI::BAT::Config::UqlJson::WriteConfig(const std::string& key, const nlohmann::json& jsonIn)
 {
+    SCI_TRACE_SCOPE("config", "UqlJson::WriteConfig");
     SCI_ASSERT(m_db, "Config database not initialized");
     SCI_ASSERT(!jsonIn.empty(), "Can't store empty json data!");
 
-    std::string jsonData = nlohmann::to_string(jsonIn);
+    auto value = std::make_shared<const nlohmann::json>(jsonIn);
+    if (m_durability != Durability::Sync)
+    {
+        // Encoded by the checkpoint (a coalesced write is never encoded)
+        Util::LockGuard janitor(m_lock);
+        return Stage(key, std::move(value));
+    }
 
+    std::string jsonData = Serialize(jsonIn);
     Util::LockGuard janitor(m_lock); // Begin critical section
-    return unqlite_kv_store(m_db, key.c_str(), key.length(), jsonData.c_str(), jsonData.length()) == UNQLITE_OK;
+    bool stored = unqlite_kv_store(m_db, key.c_str(), key.length(), jsonData.c_str(), jsonData.length()) == UNQLITE_OK && unqlite_commit(m_db) == UNQLITE_OK;
+    if (!stored)
+    {
+        // Drop the failed write (it would otherwise be committed by the next successful write)
+        unqlite_rollback(m_db);
+    }
+
+    // Write through (inside the database lock: the cache is updated in the same order as the database)
+    Util::LockGuard cacheJanitor(m_cacheLock);
+    if (stored)
+    {
+        m_cache[key] = std::move(value);
+        m_keys.insert(key);
+    }
+    else
+    {
+        m_cache.erase(key);
+    }
+    return stored;
 }
 
 bool SCI::BAT::Config::UqlJson::DeleteConfig(const std::string& key)
 {
+    SCI_TRACE_SCOPE("config", "UqlJson::DeleteConfig");
+    SCI_ASSERT(m_db, "Config database not initialized");
+
+    Util::LockGuard janitor(m_lock); // Begin critical section
+    if (m_durability != Durability::Sync)
+    {
+        // The key index knows all keys including the staged ones
+        Util::SharedLockGuard cacheJanitor(m_cacheLock);
+        bool exists = m_keys.contains(key);
+        cacheJanitor.Release();
+
+        return exists && Stage(key, nullptr);
+    }
+    bool deleted = unqlite_kv_delete(m_db, key.c_str(), key.length()) == UNQLITE_OK && unqlite_commit(m_db) == UNQLITE_OK;
+    if (!deleted)
+    {
+        unqlite_rollback(m_db);
+    }
+
+    Util::LockGuard cacheJanitor(m_cacheLock);
+    if (deleted)
+    {
+        m_cache[key] = nullptr;
+        m_keys.erase(key);
+    }
+    else
+    {
+        m_cache.erase(key);
+    }
+    return deleted;
+}
+
+bool SCI::BAT::Config::UqlJson::WriteBatch(const std::vector<BatchOperation>& operations)
+{
+    SCI_TRACE_SCOPE("config", "UqlJson::WriteBatch");
     SCI_ASSERT(m_db, "Config database not initialized");
 
+    // Encode outside the lock
+    std::vector<std::string> records(operations.size());
+    for (size_t i = 0; i < operations.size(); i++)
+    {
+        if (!operations[i].erase)
+        {
+            SCI_ASSERT(!operations[i].value.empty(), "Can't store empty json data!");
+            records[i] = Serialize(operations[i].value);
+        }
+    }
+
     Util::LockGuard janitor(m_lock); // Begin critical section
-    return unqlite_kv_delete(m_db, key.c_str(), key.length()) == UNQLITE_OK;
+    if (!CommitPending() || unqlite_begin(m_db) != UNQLITE_OK)
+    {
+        // Staged changes are committed first (a rollback of the batch must not discard them)
+        return false;
+    }
+    for (size_t i = 0; i < operations.size(); i++)
+    {
+        const auto& key = operations[i].key;
+        int rc = operations[i].erase ?
+            unqlite_kv_delete(m_db, key.c_str(), key.length()) :
+            unqlite_kv_store(m_db, key.c_str(), key.length(), records[i].c_str(), records[i].length());
+        if (rc != UNQLITE_OK)
+        {
+            RollbackBatch();
+            return false;
+        }
+    }
+    if (unqlite_commit(m_db) != UNQLITE_OK)
+    {
+        RollbackBatch();
+        return false;
+    }
+
+    // Write through (later operations on the same key win)
+    Util::LockGuard cacheJanitor(m_cacheLock);
+    for (const auto& operation : operations)
+    {
+        if (operation.erase)
+        {
+            m_cache[operation.key] = nullptr;
+            m_keys.erase(operation.key);
+        }
+        else
+        {
+            m_cache[operation.key] = std::make_shared<const nlohmann::json>(operation.value);
+            m_keys.insert(operation.key);
+        }
+    }
+    return true;
+}
+
+bool SCI::BAT::Config::UqlJson::WriteStream(const RecordSource& source)
+{
+    SCI_TRACE_SCOPE("config", "UqlJson::WriteStream");
+    SCI_ASSERT(m_db, "Config database not initialized");
+
+    std::vector<std::string> keys;
+    std::string key;
+    std::string record;
+
+    Util::LockGuard janitor(m_lock); // Begin critical section
+    if (!CommitPending() || unqlite_begin(m_db) != UNQLITE_OK)
+    {
+        // Staged changes are committed first (a rollback of the batch must not discard them)
+        return false;
+    }
+    try
+    {
+        while (source(key, record))
+        {
+            if (unqlite_kv_store(m_db, key.c_str(), key.length(), record.c_str(), record.length()) != UNQLITE_OK)
+            {
+                RollbackBatch();
+                return false;
+            }
+            keys.push_back(key);
+        }
+    }
+    catch (...)
+    {
+        RollbackBatch();
+        throw;
+    }
+    if (unqlite_commit(m_db) != UNQLITE_OK)
+    {
+        RollbackBatch();
+        return false;
+    }
+
+    // Values are parsed again on their next read (the stream may be larger than the cache should grow)
+    Util::LockGuard cacheJanitor(m_cacheLock);
+    for (auto& writtenKey : keys)
+    {
+        m_cache.erase(writtenKey);
+        m_keys.insert(std::move(writtenKey));
+    }
+    return true;
+}
+
+std::vector<std::string> SCI::BAT::Config::UqlJson::ScanPrefix(std::string_view prefix, std::string_view after, size_t limit, bool* more /*= nullptr*/) const
+{
+    SCI_TRACE_SCOPE("config", "UqlJson::ScanPrefix");
+
+    std::vector<std::string> keys;
+    Util::SharedLockGuard janitor(m_cacheLock);
+    auto itKey = after < prefix ? m_keys.lower_bound(prefix) : m_keys.upper_bound(after);
+    for (; itKey != m_keys.end() && itKey->starts_with(prefix) && keys.size() < limit; itKey++)
+    {
+        keys.push_back(*itKey);
+    }
+
+    if (more)
+    {
+        *more = itKey != m_keys.end() && itKey->starts_with(prefix);
+    }
+    return keys;
+}
+
+void SCI::BAT::Config::UqlJson::RollbackBatch()
+{
+    unqlite_rollback(m_db);
+
+    // The rollback also discards uncommitted single writes. Cached values are reread from the database
+    RebuildKeyIndex();
+    Util::LockGuard cacheJanitor(m_cacheLock);
+    m_cache.clear();
+}
+
+bool SCI::BAT::Config::UqlJson::Stage(const std::string& key, std::shared_ptr<const nlohmann::json> value)
+{
+    // A full queue means the last checkpoint failed. Retry it instead of growing the queue (coalescing writes don't grow it)
+    if (m_durability == Durability::GroupCommit && m_pending.size() >= m_maxPending && !m_pending.contains(key) && !CommitPending())
+    {
+        spdlog::error("Config checkpoint failed with {} staged changes. Write of \"{}\" refused", m_pending.size(), key);
+        return false;
+    }
+
+    Util::LockGuard cacheJanitor(m_cacheLock);
+    if (value)
+    {
+        m_keys.insert(key);
+    }
+    else
+    {
+        m_keys.erase(key);
+    }
+    m_cache[key] = value;
+    cacheJanitor.Release();
+
+    if (!m_pending.insert_or_assign(key, std::move(value)).second)
+    {
+        m_stats.coalesced++;
+    }
+    if (m_durability == Durability::GroupCommit && m_pending.size() >= m_maxPending && !CommitPending())
+    {
+        // The change stays staged and visible. The next write of a new key retries the checkpoint
+        spdlog::error("Config checkpoint failed with {} staged changes", m_pending.size());
+    }
+    return true;
+}
+
+bool SCI::BAT::Config::UqlJson::CommitPending()
+{
+    // Not traced: The destructor commits after the tracer is gone
+    if (m_pending.empty())
+    {
+        return true;
+    }
+    if (unqlite_begin(m_db) != UNQLITE_OK)
+    {
+        return false;
+    }
+    for (const auto& [key, value] : m_pending)
+    {
+        // A key written and deleted since the last checkpoint may not exist on disk
+        int rc;
+        if (value)
+        {
+            std::string data = Serialize(*value);
+            rc = unqlite_kv_store(m_db, key.c_str(), key.length(), data.c_str(), data.length());
+        }
+        else
+        {
+            rc = unqlite_kv_delete(m_db, key.c_str(), key.length());
+            rc = rc == UNQLITE_NOTFOUND ? UNQLITE_OK : rc;
+        }
+
+        if (rc != UNQLITE_OK)
+        {
+            // The cache and the key index already hold the staged state. They stay valid for the next attempt
+            unqlite_rollback(m_db);
+            return false;
+        }
+    }
+    if (unqlite_commit(m_db) != UNQLITE_OK)
+    {
+        unqlite_rollback(m_db);
+        return false;
+    }
+
+    m_pending.clear();
+    m_stats.checkpoints++;
+    return true;
+}
+
+void SCI::BAT::Config::UqlJson::RebuildKeyIndex()
+{
+    SCI_TRACE_SCOPE("config", "UqlJson::RebuildKeyIndex");
+
+    std::set<std::string, std::less<>> keys;
+    unqlite_kv_cursor* cursor = nullptr;
+    if (unqlite_kv_cursor_init(m_db, &cursor) == UNQLITE_OK)
+    {
+        for (unqlite_kv_cursor_first_entry(cursor); unqlite_kv_cursor_valid_entry(cursor); unqlite_kv_cursor_next_entry(cursor))
+        {
+            int keyLength = 0;
+            if (unqlite_kv_cursor_key(cursor, nullptr, &keyLength) == UNQLITE_OK)
+            {
+                std::string key(keyLength, '\0');
+                if (unqlite_kv_cursor_key(cursor, key.data(), &keyLength) == UNQLITE_OK)
+                {
+                    keys.insert(std::move(key));
+                }
+            }
+        }
+        unqlite_kv_cursor_release(m_db, cursor);
+    }
+
+    Util::LockGuard cacheJanitor(m_cacheLock);
+    m_keys = std::move(keys);
+}
+
+std::string SCI::BAT::Config::UqlJson::Serialize(const nlohmann::json& json)
+{
+    std::string data(BinaryTag, sizeof(BinaryTag));
+    nlohmann::json::to_cbor(json, data);
+    return data;
+}
+
+nlohmann::json SCI::BAT::Config::UqlJson::Deserialize(const char* data, size_t length)
+{
+    if (length >= sizeof(BinaryTag) && std::memcmp(data, BinaryTag, sizeof(BinaryTag)) == 0)
+    {
+        return nlohmann::json::from_cbor(data + sizeof(BinaryTag), data + length);
+    }
+
+    // Text record (not migrated yet)
+    return nlohmann::json::parse(data, data + length);
+}
+
+size_t SCI::BAT::Config::UqlJson::MigrateTextRecords()
+{
+    SCI_TRACE_SCOPE("config", "UqlJson::MigrateTextRecords");
+
+    // Collect first, the cursor must not be used while records are replaced
+    std::vector<std::pair<std::string, std::string>> records;
+    Util::LockGuard janitor(m_lock); // Begin critical section
+    unqlite_kv_cursor* cursor = nullptr;
+    if (unqlite_kv_cursor_init(m_db, &cursor) != UNQLITE_OK)
+    {
+        return 0;
+    }
+    for (unqlite_kv_cursor_first_entry(cursor); unqlite_kv_cursor_valid_entry(cursor); unqlite_kv_cursor_next_entry(cursor))
+    {
+        int keyLength = 0;
+        unqlite_int64 dataLength = 0;
+        if (unqlite_kv_cursor_key(cursor, nullptr, &keyLength) != UNQLITE_OK || unqlite_kv_cursor_data(cursor, nullptr, &dataLength) != UNQLITE_OK)
+            continue;
+
+        std::string key(keyLength, '\0');
+        std::string data(dataLength, '\0');
+        if (unqlite_kv_cursor_key(cursor, key.data(), &keyLength) == UNQLITE_OK && unqlite_kv_cursor_data(cursor, data.data(), &dataLength) == UNQLITE_OK &&
+            (data.length() < sizeof(BinaryTag) || std::memcmp(data.data(), BinaryTag, sizeof(BinaryTag)) != 0))
+        {
+            records.emplace_back(std::move(key), std::move(data));
+        }
+    }
+    unqlite_kv_cursor_release(m_db, cursor);
+
+    // Records that are no valid JSON are left as they are (reading them fails like before)
+    size_t migrated = 0;
+    for (const auto& [key, text] : records)
+    {
+        auto json = nlohmann::json::parse(text, nullptr, false);
+        if (json.is_discarded())
+            continue;
+
+        std::string data = Serialize(json);
+        if (unqlite_kv_store(m_db, key.c_str(), key.length(), data.c_str(), data.length()) == UNQLITE_OK)
+        {
+            migrated++;
+        }
+    }
+    if (migrated)
+    {
+        unqlite_commit(m_db);
+    }
+    return migrated;
 }
@@ -6,18 +6,33 @@
 #pragma once
 
 #include <SCIUtil/Exception.h>
-#include <SCIUtil/Concurrent/SpinLock.h>
+#include <SCIUtil/Concurrent/AdaptiveLock.h>
 #include <SCIUtil/Concurrent/LockGuard.h>
+#include <SCIUtil/Concurrent/SharedSpinLock.h>
+#include <SCIUtil/Concurrent/SharedLockGuard.h>
+#include <SCIUtil/Trace/Tracer.h>
 
 #include <unqlite.h>
 #include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
 
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace SCI::BAT::Config
 {
     /*!
      * @brief Singleton that provided read and write access of JSON data into the settings unqlite database.
+     * 
+     * Parsed values are cached (write through). Reads of cached keys only take a shared lock and never touch the database.
+     * Values are stored as CBOR prefixed with the CBOR self-describe tag. Text JSON records of older databases are converted by Init().
+     * Single writes and deletes are committed according to the durability mode (see Durability). Batches and streams are always committed immediately.
     */
     class UqlJson
     {
@@ -40,6 +55,51 @@ namespace SCI::BAT::Config
             static UqlJson s_instance;
 
         // Class 
+        public:
+            /*!
+             * @brief When single writes and deletes reach the disk.
+            */
+            enum class Durability
+            {
+                /*! Every write is committed before it returns */
+                Sync,
+                /*! Writes are staged and committed together by the next Checkpoint() or when too many are staged */
+                GroupCommit,
+                /*! Writes are staged and only committed by Checkpoint() (and on shutdown) */
+                Memory,
+            };
+
+            /*!
+             * @brief Counters of the staged writes
+            */
+            struct Stats
+            {
+                /*! Keys waiting for the next checkpoint */
+                size_t pending = 0;
+                /*! Writes and deletes that replaced a staged change of the same key (never written to disk) */
+                uint64_t coalesced = 0;
+                /*! Checkpoints that committed at least one change */
+                uint64_t checkpoints = 0;
+            };
+
+            /*!
+             * @brief One operation of a batch.
+            */
+            struct BatchOperation
+            {
+                /*! Name of the setting */
+                std::string key;
+                /*! New value (ignored for deletes) */
+                nlohmann::json value;
+                /*! Deletes the key instead of writing it */
+                bool erase = false;
+            };
+
+            /*!
+             * @brief Produces the next record of a stream (key and record in the on disk format). Returns false at the end of the stream.
+            */
+            using RecordSource = std::function<bool(std::string& key, std::string& record)>;
+
         public:
             ~UqlJson();
 
@@ -48,6 +108,24 @@ namespace SCI::BAT::Config
              * @param dbFile Path to database file.
             */
             void Init(const std::filesystem::path& dbFile);
+            /*!
+             * @brief Selects when single writes reach the disk. Must be called before Init().
+             * 
+             * Staged writes are visible to all reads immediately. Repeated writes of a key before the next checkpoint are coalesced (only the last one is stored).
+             * @param durability Durability mode.
+             * @param maxPending GroupCommit only: Number of staged keys that triggers a checkpoint on the writing thread. While that checkpoint fails, writes of further keys are refused.
+            */
+            void SetDurability(Durability durability, size_t maxPending = 256);
+            /*!
+             * @brief Commits all staged writes and deletes as one database transaction. Called periodically in the GroupCommit and Memory mode.
+             * @return True if nothing was staged or all changes were committed. Failed changes stay staged for the next attempt.
+            */
+            bool Checkpoint();
+            /*!
+             * @brief Retrives the counters of the staged writes.
+             * @return Copy of the counters.
+            */
+            Stats GetStats() const;
 
             /*!
              * @brief Reads a key (setting / config) form the database.
@@ -56,6 +134,12 @@ namespace SCI::BAT::Config
              * @return True if read succeeded.
             */
             bool ReadConfig(const std::string& key, nlohmann::json& jsonOut) const;
+            /*!
+             * @brief Reads a key (setting / config) without copying the value.
+             * @param key Name of the setting to be read.
+             * @return Immutable cached value. nullptr if the key does not exist.
+            */
+            std::shared_ptr<const nlohmann::json> ReadConfigShared(const std::string& key) const;
             /*!
              * @brief Writes a key (setting / config) form the database.
              * @param key Name of the setting to be written.
@@ -69,9 +153,93 @@ namespace SCI::BAT::Config
              * @return True if delete succeeded. 
             */
             bool DeleteConfig(const std::string& key);
+            /*!
+             * @brief Applies multiple writes and deletes as one database transaction (one commit).
+             * @param operations Operations in order of execution.
+             * @return True if all operations were committed. Nothing is changed otherwise.
+            */
+            bool WriteBatch(const std::vector<BatchOperation>& operations);
+            /*!
+             * @brief Stores records pulled from a source as one database transaction (one commit).
+             * 
+             * Only the keys are kept in memory. The source is called while the database is locked and must not access the UqlJson.
+             * Cached values of the written keys are dropped after the commit. If the source throws, the transaction is rolled back and the exception is rethrown.
+             * @param source Source of the records.
+             * @return True if all records were committed. Nothing is changed otherwise.
+            */
+            bool WriteStream(const RecordSource& source);
+
+            /*!
+             * @brief Lists keys starting with a prefix in ascending order (served from the key index, no database access).
+             * @param prefix Common prefix of the keys ("user." lists all users). An empty prefix lists all keys.
+             * @param after Continuation: Only keys greater than this key are listed (empty for the first page).
+             * @param limit Maximum number of keys.
+             * @param more Set to true if more keys follow the returned page (optional).
+             * @return Matching keys.
+            */
+            std::vector<std::string> ScanPrefix(std::string_view prefix, std::string_view after, size_t limit, bool* more = nullptr) const;
+
+            /*!
+             * @brief Encodes a value in the on disk format.
+             * @param json Value to encode.
+             * @return Self-describe tag followed by the CBOR encoded value.
+            */
+            static std::string Serialize(const nlohmann::json& json);
+            /*!
+             * @brief Decodes a stored value (CBOR or text JSON of older databases).
+             * @param data Stored record.
+             * @param length Length of the record.
+             * @return Decoded value.
+            */
+            static nlohmann::json Deserialize(const char* data, size_t length);
 
         private:
-            mutable Util::SpinLock m_lock;
+            /*!
+             * @brief Rewrites all text JSON records as CBOR.
+             * @return Number of converted records.
+            */
+            size_t MigrateTextRecords();
+            /*!
+             * @brief Rolls back the open transaction and drops the cache (caller holds m_lock).
+            */
+            void RollbackBatch();
+            /*!
+             * @brief Stages a write or delete for the next checkpoint and updates the cache (caller holds m_lock).
+             * @param key Name of the setting.
+             * @param value New value (nullptr deletes the key).
+             * @return False if the change was not staged (the queue is full and the checkpoint failed).
+            */
+            bool Stage(const std::string& key, std::shared_ptr<const nlohmann::json> value);
+            /*!
+             * @brief Commits the staged changes (caller holds m_lock).
+             * @return True if nothing was staged or all changes were committed.
+            */
+            bool CommitPending();
+            /*!
+             * @brief Rebuilds the key index with a cursor over the whole database (caller holds m_lock).
+            */
+            void RebuildKeyIndex();
+
+        private:
+            /*! CBOR self-describe tag (55799). Text JSON never starts with these bytes */
+            static constexpr char BinaryTag[3] = { (char)0xD9, (char)0xD9, (char)0xF7 };
+
+            using CacheEntry = std::shared_ptr<const nlohmann::json>;
+
+            mutable Util::AdaptiveLock m_lock{ "config.db" };
+
+            // Parsed values (nullptr: key known to be absent). Entries are never erased, a delete stores nullptr
+            mutable Util::SharedSpinLock m_cacheLock;
+            mutable std::unordered_map<std::string, CacheEntry> m_cache;
+
+            // Sorted index of all keys (unqlite cursors iterate in hash order). Guarded by m_cacheLock, updated with the cache
+            std::set<std::string, std::less<>> m_keys;
+
+            // Staged changes (nullptr: delete). Guarded by m_lock
+            Durability m_durability = Durability::Sync;
+            size_t m_maxPending = 256;
+            std::unordered_map<std::string, CacheEntry> m_pending;
+            Stats m_stats;
 
             unqlite* m_db = nullptr;
     };
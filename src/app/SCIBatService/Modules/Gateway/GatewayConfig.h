@@ -0,0 +1,36 @@
+/*!
+ * @file GatewayConfig.h
+ * @brief Typed configuration of the gateway module (config key "gateway").
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <Config/Schema.h>
+
+#include <string>
+#include <tuple>
+
+namespace SCI::BAT::Gateway
+{
+    /*!
+     * @brief Connection to the SMA inverter.
+    */
+    struct GatewayConfig
+    {
+        /*! IPv4 address of the inverter */
+        std::string address = "10.27.210.78";
+        /*! Modbus TCP port of the inverter */
+        int port = 502;
+        /*! Modbus node id of the inverter */
+        int node = 3;
+        /*! Polling interval in ms */
+        int pollrate = 3000;
+
+        static constexpr auto Fields = std::make_tuple(
+            Config::MakeField("address", &GatewayConfig::address),
+            Config::MakeField("port", &GatewayConfig::port, 1, 65535),
+            Config::MakeField("node", &GatewayConfig::node, 0, 255),
+            Config::MakeField("pollrate", &GatewayConfig::pollrate, 10, 3600000)
+        );
+    };
+}
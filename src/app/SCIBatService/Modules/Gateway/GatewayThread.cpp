@@ -6,25 +6,32 @@ SCI::BAT::Gateway::GatewayThread::GatewayThread(Mailbox::MailboxThread& mailbox,
     m_modbus(64, 64),
     m_mailbox(mailbox)
 {
+    SetName("gateway");
     SetLogger(gatewayLogger);
     m_modbus.SetLogger(gatewayLogger);
 
-    m_smaOutputData.enablePowerControle = true;
+    m_smaOutputData.Update([](SMAOutData& od) { od.enablePowerControle = true; });
 
     // Activate static gateway
     s_gateway = this;
 
     LoadConfig();
+    m_configWatch = Config::AuthenticateConfig::Watch("gateway", [this](const std::string&, const nlohmann::json& oldData, const nlohmann::json& newData) { OnConfigChange(oldData, newData); });
+
+    // Handle power commands as soon as they arrive
+    m_mailbox.Subscribe(std::filesystem::path("battery") / "setpoint", [this](std::string_view, std::string_view payload) { OnSetpointMessage(payload); });
+}
+
+SCI::BAT::Gateway::GatewayThread::~GatewayThread()
+{
+    Config::AuthenticateConfig::Unwatch(m_configWatch);
 }
 
 int SCI::BAT::Gateway::GatewayThread::ThreadMain()
 {
     using namespace std::chrono_literals;
 
-    // Read configuration
-    LoadConfig();
-
-    // Setup SMA Mappings
+    // Setup SMA Mappings (config loaded by the constructor, later changes are applied by the loop)
     NetTools::IPV4Endpoint smaEndpoint;
     std::string smaEndpointStr = fmt::format("{}:{}", m_smaIp, m_smaPort);
     SCI_ASSERT_FMT(smaEndpoint.Parse(smaEndpointStr), "Failed to parse \"{}\" as IPv4 endpoint!", smaEndpointStr);
@@ -78,6 +85,7 @@ int SCI::BAT::Gateway::GatewayThread::ThreadMain()
     int dStatsCounter = 0;
     while (!StopRequested())
     {
+        ThreadProfile::Iteration iteration(GetProfile());
         auto f = 4;
 
         // Debug stats print
@@ -85,10 +93,11 @@ int SCI::BAT::Gateway::GatewayThread::ThreadMain()
         {
             if (m_modbus.SlaveConnected("sma"))
             {
-
-                GetLogger()->debug("SMA Status: {}, Power: {}W, PowerSetpoint: {}W, Voltage: {}V, Freqency: {}Hz, BatteryCurrent: {}A, BatteryCharge: {}%, BatteryCapacity: {}%, BatteryTemperature: {}gC, BatteryVoltage: {}V, RemainingChargeTime: {}s, RemainingDischargeTime: {}s, BatteryStatus: {}, OperationStatus: {}, BatteryType: {}, SerialNumber: {:#08x}",
-                    m_smaInputData.status, m_smaInputData.power, m_smaOutputData.power, m_smaInputData.voltage, m_smaInputData.freqenency, m_smaInputData.batteryCurrent, m_smaInputData.batteryCharge, m_smaInputData.batteryCapacity, m_smaInputData.batteryTemperature, m_smaInputData.batteryVoltage, 
-                    m_smaInputData.timeUntilFullCharge, m_smaInputData.timeUntilFullDischarge, m_smaInputData.batteryStatus, m_smaInputData.operationStaus, m_smaInputData.batteryType, static_cast<unsigned>(m_smaInputData.serialNumber));
+                auto smaInputData = m_smaInputData.Load();
+                auto smaOutputData = m_smaOutputData.Load();
+                SCI_LOG_DEBUG(GetLogger(), "SMA Status: {}, Power: {}W, PowerSetpoint: {}W, Voltage: {}V, Freqency: {}Hz, BatteryCurrent: {}A, BatteryCharge: {}%, BatteryCapacity: {}%, BatteryTemperature: {}gC, BatteryVoltage: {}V, RemainingChargeTime: {}s, RemainingDischargeTime: {}s, BatteryStatus: {}, OperationStatus: {}, BatteryType: {}, SerialNumber: {:#08x}",
+                    smaInputData.status, smaInputData.power, smaOutputData.power, smaInputData.voltage, smaInputData.freqenency, smaInputData.batteryCurrent, smaInputData.batteryCharge, smaInputData.batteryCapacity, smaInputData.batteryTemperature, smaInputData.batteryVoltage, 
+                    smaInputData.timeUntilFullCharge, smaInputData.timeUntilFullDischarge, smaInputData.batteryStatus, smaInputData.operationStaus, smaInputData.batteryType, static_cast<unsigned>(smaInputData.serialNumber));
             }
             dStatsCounter = 0;
         }
@@ -99,71 +108,58 @@ int SCI::BAT::Gateway::GatewayThread::ThreadMain()
             GetLogger()->info("Config reload requested.");
             LoadConfig();
 
-            GetLogger()->info("Updating modbus slave connection information");
-            NetTools::IPV4Endpoint smaEndpoint;
-            std::string smaEndpointStr = fmt::format("{}:{}", m_smaIp, m_smaPort);
-            if (smaEndpoint.Parse(smaEndpointStr))
-            {
-                m_modbus.SetupSlave("sma").UpdateConnection(smaEndpoint, m_smaPort);
-            }
-            else
+            if (m_connectionChanged.exchange(false))
             {
-                GetLogger()->error("Failed to update inverter modbus ip to \"{}\".", m_smaIp);
+                GetLogger()->info("Updating modbus slave connection information");
+                NetTools::IPV4Endpoint smaEndpoint;
+                std::string smaEndpointStr = fmt::format("{}:{}", m_smaIp, m_smaPort);
+                if (smaEndpoint.Parse(smaEndpointStr))
+                {
+                    m_modbus.SetupSlave("sma").UpdateConnection(smaEndpoint, m_smaSlaveNode);
+                }
+                else
+                {
+                    GetLogger()->error("Failed to update inverter modbus ip to \"{}\".", m_smaIp);
+                }
             }
 
             DoneConfigChange();
         }
 
-        // Read & write modbus values
-        Util::LockGuard janitor(m_dataLock);
-        SMAReadInputData(m_modbus, m_smaInputData);
-        SMAWriteOutputData(m_modbus, m_smaOutputData);
-        janitor.Release();
+        // Read & write modbus values (readers never block the gateway)
+        SMAInData smaInputData;
+        SMAReadInputData(m_modbus, smaInputData);
+        m_smaInputData.Store(smaInputData);
+        auto smaOutputData = m_smaOutputData.Load();
+        SMAWriteOutputData(m_modbus, smaOutputData);
 
         // Update modbus IO
-        GetLogger()->debug("Initiating gateway periodic update");
+        SCI_LOG_DEBUG(GetLogger(), "Initiating gateway periodic update");
         m_smaConnected = m_modbus.SlaveConnected("sma");
         auto updateOk = m_modbus.IOUpdate(0.0001f * m_refRateInMs);
         m_smaUpdateOk = m_smaConnected ? updateOk : false;
 
-        // Read the modbus command
-        std::string mqttRequestPowerStr;
-        if (m_mailbox.GetMQTTMessage(std::filesystem::path("battery") / "setpoint", mqttRequestPowerStr))
-        {
-            int32_t powerSetpoint = std::numeric_limits<int32_t>::max();
-            std::stringstream ss;
-            ss << mqttRequestPowerStr;
-            ss >> powerSetpoint;
-
-            if (powerSetpoint != std::numeric_limits<int32_t>::max() && !ss.fail())
-            {
-                GetLogger()->info("Power was set to {}W via MQTT", powerSetpoint);
-                m_smaOutputData.enablePowerControle = true;
-                m_smaOutputData.power = powerSetpoint;
-            }
-            else
-            {
-                GetLogger()->warn("Invalid MQTT input for Power Setpoint \"{}\"", mqttRequestPowerStr);
-            }
-        }
-
         // Write data to MQTT
-        PublishMQTTInfo(m_smaInputData, m_smaOutputData);
+        PublishMQTTInfo(smaInputData, smaOutputData);
 
-        // Wait one second
-        std::this_thread::sleep_for(1ms * m_refRateInMs);
+        // Wait for the next cycle (a new setpoint will wake us early)
+        iteration.End();
+        Sleep(1ms * m_refRateInMs);
     }
 
     // Shutdown
     GetLogger()->info("Shutdown requested! Asserting save modbus state");
-    m_smaOutputData.enablePowerControle = true;
-    m_smaOutputData.power = 0;
-    SMAWriteOutputData(m_modbus, m_smaOutputData);
+    SMAOutData smaOutputData;
+    smaOutputData.enablePowerControle = true;
+    smaOutputData.power = 0;
+    m_smaOutputData.Store(smaOutputData);
+    SMAWriteOutputData(m_modbus, smaOutputData);
     m_modbus.IOUpdate(99999.0f); // Large number to force reconnect
     std::this_thread::sleep_for(3s);
-    m_smaOutputData.enablePowerControle = false;
-    m_smaOutputData.power = 0;
-    SMAWriteOutputData(m_modbus, m_smaOutputData);
+    smaOutputData.enablePowerControle = false;
+    smaOutputData.power = 0;
+    m_smaOutputData.Store(smaOutputData);
+    SMAWriteOutputData(m_modbus, smaOutputData);
     m_modbus.IOUpdate(99999.0f);
 
     return 0;
@@ -174,6 +170,29 @@ void SCI::BAT::Gateway::GatewayThread::OnStop()
     // We don't need to catch the event
 }
 
+void SCI::BAT::Gateway::GatewayThread::OnSetpointMessage(std::string_view payload)
+{
+    int32_t powerSetpoint = 0;
+    auto* payloadEnd = payload.data() + payload.length();
+    auto result = std::from_chars(payload.data(), payloadEnd, powerSetpoint);
+    if (result.ec == std::errc() && result.ptr == payloadEnd)
+    {
+        GetLogger()->info("Power was set to {}W via MQTT", powerSetpoint);
+        m_smaOutputData.Update([&](SMAOutData& od)
+            {
+                od.enablePowerControle = true;
+                od.power = powerSetpoint;
+            });
+
+        // Apply without waiting for the next poll
+        Wake();
+    }
+    else
+    {
+        GetLogger()->warn("Invalid MQTT input for Power Setpoint \"{}\"", payload);
+    }
+}
+
 void SCI::BAT::Gateway::GatewayThread::PublishMQTTInfo(const SMAInData& id, const SMAOutData& od)
 {
     // Battery capacity as normalized float
@@ -275,33 +294,48 @@ void SCI::BAT::Gateway::GatewayThread::SMAWriteOutputData(Modbus::Master& modbus
     }
 }
 
-void SCI::BAT::Gateway::GatewayThread::LoadConfig()
+void SCI::BAT::Gateway::GatewayThread::OnConfigChange(const nlohmann::json& oldData, const nlohmann::json& newData)
+{
+    // Runs on the writing thread: Only flag what the change affects, the gateway thread applies it
+    GatewayConfig oldConfig, newConfig;
+    std::string error;
+    Config::Schema<GatewayConfig>::FromJson(oldData, oldConfig, error);
+    Config::Schema<GatewayConfig>::FromJson(newData, newConfig, error);
+    if (Config::Schema<GatewayConfig>::Differs(oldConfig, newConfig, "address") || Config::Schema<GatewayConfig>::Differs(oldConfig, newConfig, "port") || Config::Schema<GatewayConfig>::Differs(oldConfig, newConfig, "node"))
+    {
+        m_connectionChanged = true;
+    }
+    ConfigReload();
+}
+
+void SCI::BAT::Gateway::GatewayThread::RegisterConfigSchema()
+{
+    Config::AuthenticateConfig::RegisterSchema<GatewayConfig>("gateway");
+}
+
+void SCI::BAT::Gateway::GatewayThread::InsertDefaultConfig(Config::AuthenticateConfig::Transaction& defaults)
 {
-    // Assert config node existence
-    GetLogger()->debug("Asserting default config.");
-    Config::AuthenticateConfig::InsertData(
+    defaults.InsertDefaults<GatewayConfig>(
         "gateway",
-        (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System,
-        {
-            { "address", "10.27.210.78" },
-            { "port", 502 },
-            { "node", 3 },
-            { "pollrate", 3000 },
-        }
+        (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System
     );
+}
 
-    // Now read current config
-    nlohmann::json config;
-    GetLogger()->debug("Reading config from db.");
-    if (Config::AuthenticateConfig::ReadData("gateway", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, config))
+void SCI::BAT::Gateway::GatewayThread::LoadConfig()
+{
+    // Read current config (the defaults are inserted on startup, see InsertDefaultConfig)
+    GatewayConfig config;
+    std::string error;
+    SCI_LOG_DEBUG(GetLogger(), "Reading config from db.");
+    if (Config::AuthenticateConfig::ReadTyped("gateway", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, config, error))
     {
-        m_smaIp = config["address"];
-        m_smaPort = config["port"];
-        m_smaSlaveNode = config["node"];
-        m_refRateInMs = config["pollrate"];
+        m_smaIp = config.address;
+        m_smaPort = config.port;
+        m_smaSlaveNode = config.node;
+        m_refRateInMs = config.pollrate;
     }
     else
     {
-        GetLogger()->error("Failed to read config.");
+        GetLogger()->error("Failed to read config: {}", error);
     }
 }
@@ -7,16 +7,21 @@
 
 #include <Threading/Thread.h>
 #include <Config/AuthenticatedConfig.h>
+#include <Modules/Gateway/GatewayConfig.h>
 #include <Modules/Gateway/SMAData.h>
 #include <Modules/Mailbox/MailboxThread.h>
 #include <Modules/Webserver/HTTPAuthentication.h>
 
 #include <SCIUtil/SPDLogable.h>
 #include <SCIUtil/Exception.h>
-#include <SCIUtil/Concurrent/SpinLock.h>
-#include <SCIUtil/Concurrent/LockGuard.h>
+#include <SCIUtil/Concurrent/SeqLock.h>
 #include <ModbusMaster/Master.h>
 
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace SCI::BAT::Gateway
 {
     /*!
@@ -26,18 +31,17 @@ namespace SCI::BAT::Gateway
     {
         public:
             GatewayThread(Mailbox::MailboxThread& mailbox, const std::shared_ptr<spdlog::logger>& gatewayLogger = spdlog::default_logger());
+            ~GatewayThread();
 
             static inline SMAInData GetInputData()
             {
                 SCI_ASSERT(s_gateway, "Gateway not initialized");
-                Util::LockGuard janitor(s_gateway->m_dataLock);
-                return s_gateway->m_smaInputData;
+                return s_gateway->m_smaInputData.Load();
             }
             static inline SMAOutData GetOuputData()
             {
                 SCI_ASSERT(s_gateway, "Gateway not initialized");
-                Util::LockGuard janitor(s_gateway->m_dataLock);
-                return s_gateway->m_smaOutputData;
+                return s_gateway->m_smaOutputData.Load();
             }
             static inline auto GetStaticTID()
             {
@@ -48,12 +52,6 @@ namespace SCI::BAT::Gateway
                 return s_gateway->IsFinished();
             }
 
-            static inline void ReloadAllModules()
-            {
-                s_gateway->GetLogger()->info("Initiating module reloading.");
-                s_gateway->RaisConfigChange();
-            }
-
             static inline auto GetConnectionString()
             {
                 return fmt::format("{}:{} (NodeId: {})", s_gateway->m_smaIp, s_gateway->m_smaPort, s_gateway->m_smaSlaveNode);
@@ -71,10 +69,21 @@ namespace SCI::BAT::Gateway
                 s_gateway->RaisSystemStopRequest();
             }
 
+            /*!
+             * @brief Registers the schema of the config setting (writes and snapshot imports are validated against it).
+            */
+            static void RegisterConfigSchema();
+            /*!
+             * @brief Stages the insertion of the default config (only inserted if the setting does not exist).
+             * @param defaults Startup transaction of all defaults.
+            */
+            static void InsertDefaultConfig(Config::AuthenticateConfig::Transaction& defaults);
+
         protected:
             int ThreadMain() override;
             void OnStop() override;
 
+            void OnSetpointMessage(std::string_view payload);
             void PublishMQTTInfo(const SMAInData& id, const SMAOutData& od);
 
             static void SMAReadInputData(Modbus::Master& modbus, SMAInData& smaIn);
@@ -82,19 +91,23 @@ namespace SCI::BAT::Gateway
 
         private:
             void LoadConfig();
+            void OnConfigChange(const nlohmann::json& oldData, const nlohmann::json& newData);
 
         private:
             static GatewayThread* s_gateway;
 
-            Util::SpinLock m_dataLock;
-            SMAInData m_smaInputData;
-            SMAOutData m_smaOutputData;
+            Util::SeqLock<SMAInData> m_smaInputData;
+            Util::SeqLock<SMAOutData> m_smaOutputData;
 
             std::string m_smaIp = "0.0.0.0";
             int m_smaSlaveNode = 3;
             int m_smaPort = 502;
             int m_refRateInMs = 3000;
 
+            // Config subscription (only endpoint changes require a new modbus connection)
+            uint64_t m_configWatch = 0;
+            std::atomic_bool m_connectionChanged = false;
+
             bool m_smaUpdateOk = false;
             bool m_smaConnected = false;
 
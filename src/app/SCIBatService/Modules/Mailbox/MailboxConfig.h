@@ -0,0 +1,82 @@
+/*!
+ * @file MailboxConfig.h
+ * @brief Typed configuration of the MQTT mailbox (config key "mailbox").
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <Config/Schema.h>
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace SCI::BAT::Mailbox
+{
+    /*!
+     * @brief Broker connection, spooling and delivery settings.
+    */
+    struct MailboxConfig
+    {
+        /*! Host of the broker */
+        std::string brokerAddress = "localhost";
+        /*! Broker user (empty for anonymous) */
+        std::string brokerUsername = "";
+        /*! Broker password */
+        std::string brokerPassword = "";
+        /*! Port of the broker */
+        int brokerPort = 1883;
+        /*! Prefix of all topics */
+        std::string baseTopic = "sci-bat";
+        /*! Maximum size of the offline spool in bytes */
+        size_t spoolSize = 16 * 1024 * 1024;
+        /*! Spooled messages replayed per loop iteration */
+        unsigned int replayRate = 50;
+        /*! First reconnect delay */
+        std::chrono::milliseconds reconnectMin = std::chrono::milliseconds(1000);
+        /*! Largest reconnect delay */
+        std::chrono::milliseconds reconnectMax = std::chrono::milliseconds(60000);
+        /*! Interval of the metrics message (0 disables it) */
+        std::chrono::milliseconds metricsInterval = std::chrono::milliseconds(10000);
+        /*! Maximum number of unacknowledged messages */
+        size_t inflight = 20;
+        /*! QoS per topic filter */
+        std::map<std::string, int> qos = {
+            { "#", 0 },
+            { "battery/#", 1 },
+            { "inverter/#", 1 },
+        };
+
+        static constexpr auto Fields = std::make_tuple(
+            Config::MakeField("broker.address", &MailboxConfig::brokerAddress),
+            Config::MakeField("broker.username", &MailboxConfig::brokerUsername),
+            Config::MakeField("broker.password", &MailboxConfig::brokerPassword),
+            Config::MakeField("broker.port", &MailboxConfig::brokerPort, 1, 65535),
+            Config::MakeField("basetopic", &MailboxConfig::baseTopic),
+            Config::MakeField("spool.size", &MailboxConfig::spoolSize, 64 * 1024, 1024 * 1024 * 1024),
+            Config::MakeField("spool.replayrate", &MailboxConfig::replayRate, 0, 100000),
+            Config::MakeField("reconnect.min", &MailboxConfig::reconnectMin, 1, 3600000),
+            Config::MakeField("reconnect.max", &MailboxConfig::reconnectMax, 1, 3600000),
+            Config::MakeField("metrics.interval", &MailboxConfig::metricsInterval, 0, 86400000),
+            Config::MakeField("delivery.inflight", &MailboxConfig::inflight, 1, 65535),
+            Config::MakeField("delivery.qos", &MailboxConfig::qos, 0, 2)
+        );
+
+        /*!
+         * @brief Checks the constraints between the fields (see Config::Schema)
+         * @param value Decoded config
+         * @param error Receives the reason if the config is invalid
+         * @return True if the config is valid
+        */
+        static inline bool Check(const MailboxConfig& value, std::string& error)
+        {
+            if (value.reconnectMin > value.reconnectMax)
+            {
+                error = "\"reconnect.min\": larger than reconnect.max";
+                return false;
+            }
+            return true;
+        }
+    };
+}
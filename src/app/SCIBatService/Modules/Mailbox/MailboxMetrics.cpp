@@ -0,0 +1,33 @@
+#include "MailboxMetrics.h"
+
+nlohmann::json SCI::BAT::Mailbox::MailboxMetrics::ToJson() const
+{
+    return {
+        { "messagesSent", messagesSent.load() },
+        { "bytesSent", bytesSent.load() },
+        { "messagesReceived", messagesReceived.load() },
+        { "bytesReceived", bytesReceived.load() },
+        { "messagesSpooled", messagesSpooled.load() },
+        { "messagesLost", messagesLost.load() },
+        { "publishFailures", publishFailures.load() },
+        { "reconnects", reconnects.load() },
+        { "disconnects", disconnects.load() },
+        { "spoolDepth", spoolDepth.load() },
+        { "inflight", inflight.load() },
+        { "ackLatencyUs", ToJson(ackLatency) },
+        { "loopTimeUs", ToJson(loopTime) },
+    };
+}
+
+nlohmann::json SCI::BAT::Mailbox::MailboxMetrics::ToJson(const Util::Histogram& histogram)
+{
+    auto snapshot = histogram.Read();
+    return {
+        { "count", snapshot.count },
+        { "mean", snapshot.Mean() },
+        { "p50", snapshot.Percentile(0.5) },
+        { "p90", snapshot.Percentile(0.9) },
+        { "p99", snapshot.Percentile(0.99) },
+        { "max", snapshot.max },
+    };
+}
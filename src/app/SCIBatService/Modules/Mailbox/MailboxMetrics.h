@@ -0,0 +1,63 @@
+/*!
+ * @file MailboxMetrics.h
+ * @brief Counters and histograms describing the MQTT mailbox.
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <SCIUtil/Metrics/Histogram.h>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace SCI::BAT::Mailbox
+{
+    /*!
+     * @brief Metrics of the mailbox. Written by the mailbox (and publishing threads), read lock free by everyone.
+    */
+    struct MailboxMetrics
+    {
+        /*! Messages handed to the broker (direct and replayed) */
+        std::atomic<uint64_t> messagesSent = 0;
+        /*! Payload bytes handed to the broker */
+        std::atomic<uint64_t> bytesSent = 0;
+        /*! Messages received on the control topic */
+        std::atomic<uint64_t> messagesReceived = 0;
+        /*! Payload bytes received on the control topic */
+        std::atomic<uint64_t> bytesReceived = 0;
+        /*! Messages stored in the spool */
+        std::atomic<uint64_t> messagesSpooled = 0;
+        /*! Messages that could neither be send nor spooled */
+        std::atomic<uint64_t> messagesLost = 0;
+        /*! Failed mosquitto publish calls */
+        std::atomic<uint64_t> publishFailures = 0;
+        /*! Connection attempts */
+        std::atomic<uint64_t> reconnects = 0;
+        /*! Lost connections */
+        std::atomic<uint64_t> disconnects = 0;
+
+        /*! Messages waiting in the spool */
+        std::atomic<uint64_t> spoolDepth = 0;
+        /*! Messages not yet acknowledged by the broker */
+        std::atomic<uint64_t> inflight = 0;
+
+        /*! Latency from publish to broker acknowledgement (microseconds) */
+        Util::Histogram ackLatency;
+        /*! Duration of one mailbox loop iteration (microseconds) */
+        Util::Histogram loopTime;
+
+        /*!
+         * @brief Converts the current values to json
+         * @return Json object
+        */
+        nlohmann::json ToJson() const;
+        /*!
+         * @brief Converts a histogram to json (count, mean, percentiles and max)
+         * @param histogram Histogram to be converted
+         * @return Json object
+        */
+        static nlohmann::json ToJson(const Util::Histogram& histogram);
+    };
+}
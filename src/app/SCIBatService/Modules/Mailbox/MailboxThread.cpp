@@ -6,114 +6,196 @@ int SCI::BAT::Mailbox::MailboxThread::ThreadMain()
 {
     using namespace std::chrono_literals;
 
-    MQTTConnect();
+    // This thread drives the network loop. Publishing from other threads only queues the packet and wakes the loop
+    threaded_set(true);
+    SchedulePublishMetrics();
 
     while (!StopRequested())
     {
-        // Loop MQTT
-        if (m_isConnected)
-        {
-            Util::LockGuard janitor(m_mosqLock);
-            loop(100);
-        }
+        auto iterationStart = std::chrono::steady_clock::now();
+        ThreadProfile::Iteration iteration(GetProfile());
 
+        // Update config
         Util::LockGuard janitor(m_lock);
-        
-        // Check for errors
-        if (m_hasError)
+        if (ConfigReloadRequested())
         {
-            GetLogger()->warn("MQTT Mailbox had issue. Trying to reconnect.");
-            if (!m_isConnected || reconnect_async() != MOSQ_ERR_SUCCESS)
+            GetLogger()->info("Config change requested! Reloading config.");
+            LoadConfig();
+            if (m_reconnectRequested.exchange(false))
             {
+                GetLogger()->info("Config change requested! Restarting MQTT connection.");
                 MQTTDisconnect();
-                MQTTConnect();
+                m_backoff = 0ms;
+                m_nextConnect = iterationStart;
             }
-            m_hasError = false;
+            if (m_spoolSize != m_spoolOpenSize)
+            {
+                Util::LockGuard mosqJanitor(m_mosqLock);
+                OpenSpool();
+            }
+            SchedulePublishMetrics();
+            DoneConfigChange();
         }
-        // Update config
-        if (ConfigReloadRequested())
+        janitor.Release();
+
+        // Connection state machine
+        switch (m_state)
         {
-            GetLogger()->info("Config change requested! Reloading config.");
-            LoadConfig();
-            GetLogger()->info("Config change requested! Restarting MQTT connection.");
-            MQTTDisconnect();
-            MQTTConnect();
-            DoneConfigChange();
+            case ConnectionState::Disconnected:
+                if (iterationStart >= m_nextConnect)
+                {
+                    MQTTConnect();
+                }
+                break;
+            case ConnectionState::Connecting:
+                if (iterationStart - m_connectStarted > ConnectTimeout)
+                {
+                    GetLogger()->warn("MQTT broker did not answer within {}s.", std::chrono::duration_cast<std::chrono::seconds>(ConnectTimeout).count());
+                    MQTTDisconnect();
+                    ScheduleReconnect();
+                }
+                break;
+            case ConnectionState::Connected:
+                break;
+        }
+
+        // Loop MQTT (blocks until network activity, a publish from another thread or the timeout)
+        iteration.End();
+        if (m_state != ConnectionState::Disconnected)
+        {
+            auto timeout = !m_spool.Empty() && m_state == ConnectionState::Connected ? 100ms : 1000ms;
+            auto result = loop((int)timeout.count());
+            if (result != MOSQ_ERR_SUCCESS && m_state != ConnectionState::Disconnected)
+            {
+                SCI_LOG_DEBUG(GetLogger(), "MQTT network loop failed with code {}.", result);
+                MQTTDisconnect();
+                ScheduleReconnect();
+            }
+            else
+            {
+                ReplaySpool();
+            }
         }
 
-        // Try connection 
-        if (!m_isConnected)
+        // Write the spool back to disk from time to time
+        auto now = std::chrono::steady_clock::now();
+        if (now - m_spoolFlushTime > 1s)
         {
-            MQTTConnect();
+            m_spool.Flush();
+            m_spoolFlushTime = now;
         }
 
-        janitor.Release();
+        m_metrics.loopTime.Record((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(now - iterationStart).count());
 
-        // Give the CPU headroom
-        std::this_thread::sleep_for(20ms);
+        // Wait for the next connection attempt (a config change or stop request ends the wait early)
+        if (m_state == ConnectionState::Disconnected && now < m_nextConnect)
+        {
+            Sleep(std::min<std::chrono::steady_clock::duration>(m_nextConnect - now, 1s));
+        }
     }
 
+    // Let the network loop send the disconnect
+    Executor::Get().Cancel(m_metricsTask);
     MQTTDisconnect();
+    loop(100);
+    m_spool.Flush();
     return 0;
 }
 
+SCI::BAT::Mailbox::MailboxThread::~MailboxThread()
+{
+    Config::AuthenticateConfig::Unwatch(m_configWatch);
+}
+
 void SCI::BAT::Mailbox::MailboxThread::OnStop()
 {
     // We don't need to catch the event
 }
 
 
-bool SCI::BAT::Mailbox::MailboxThread::Publish(const std::filesystem::path& subTopic, const std::string& text)
+bool SCI::BAT::Mailbox::MailboxThread::Publish(const std::filesystem::path& subTopic, const std::string& text, int qos)
 {
-    // Well... we will block here too...
+    SCI_TRACE_SCOPE("mqtt", "MailboxThread::Publish");
+
+    auto subTopicString = subTopic.generic_string();
+
+    // The base topic is guarded by the mosquitto lock (changed by a config reload)
     Util::LockGuard janitor(m_mosqLock);
+    auto topic = (m_baseTopic / "status" / subTopic).generic_string();
 
-    if (m_isConnected)
+    if (qos < 0)
     {
-        auto topic = m_baseTopic / "status" / subTopic;
-        GetLogger()->trace("Sending MQTT message on topic \"{}\": \"{}\".", topic.generic_string(), text);
-        auto result = publish(nullptr, topic.generic_string().c_str(), text.length(), text.c_str(), 0, true);
-        if (result != MOSQ_ERR_SUCCESS)
+        qos = ResolveQoS(subTopicString);
+    }
+
+    // Send directly only when nothing is waiting in the spool (messages must arrive in order)
+    if (m_state == ConnectionState::Connected && m_spool.Empty())
+    {
+        // Backpressure: Acknowledged delivery requires a free slot in the in-flight window
+        if (qos == 0 || m_metrics.inflight < m_inflightWindow)
         {
-            if (reconnect_async() == MOSQ_ERR_SUCCESS)
+            SCI_LOG_TRACE(GetLogger(), "Sending MQTT message on topic \"{}\" (QoS {}): \"{}\".", topic, qos, text);
+            int mid = 0;
+            auto result = publish(&mid, topic.c_str(), text.length(), text.c_str(), qos, true);
+            if (result == MOSQ_ERR_SUCCESS)
             {
-                // Retry
-                GetLogger()->debug("Reconnected to mosquitto broker.");
-                result = publish(nullptr, topic.generic_string().c_str(), text.length(), text.c_str(), 0, true);
-                if (result == MOSQ_ERR_SUCCESS)
+                SCI_LOG_TRACE(GetLogger(), "MQTT Message send successfully (Message ID: {})!", mid);
+                m_metrics.messagesSent++;
+                m_metrics.bytesSent += text.length();
+                if (qos > 0)
+                {
+                    m_pendingAcks[mid] = std::chrono::steady_clock::now();
+                    m_metrics.inflight++;
+                }
+                else
                 {
-                    GetLogger()->trace("MQTT Message send successfully!");
                     m_mqttUpdated = true;
-                    return true;
                 }
+                return true;
             }
 
-            GetLogger()->warn("Failed to publish MQTT message on topic \"{}\" error code {}.", topic.generic_string(), result);
-            m_hasError = true;
+            // The mailbox thread will notice the broken connection. The message is kept in the spool
+            SCI_LOG_DEBUG(GetLogger(), "Failed to publish MQTT message on topic \"{}\" error code {}.", topic, result);
+            m_metrics.publishFailures++;
+            m_mqttUpdated = false;
         }
         else
         {
-            GetLogger()->trace("MQTT Message send successfully!");
-            m_mqttUpdated = true;
-            return true;
+            SCI_LOG_TRACE(GetLogger(), "MQTT in-flight window full. Spooling message on topic \"{}\".", topic);
         }
     }
+    else if (m_state != ConnectionState::Connected)
+    {
+        m_mqttUpdated = false;
+    }
 
-    m_mqttUpdated = false;
+    // Store message for later delivery
+    if (m_spool.Push(topic, text))
+    {
+        SCI_LOG_TRACE(GetLogger(), "Spooled MQTT message on topic \"{}\".", topic);
+        m_metrics.messagesSpooled++;
+        m_metrics.spoolDepth = m_spool.Count();
+        return true;
+    }
+
+    GetLogger()->warn("Failed to spool MQTT message on topic \"{}\". Message lost.", topic);
+    m_metrics.messagesLost++;
     return false;
 }
 
-bool SCI::BAT::Mailbox::MailboxThread::MQTTConnect()
+void SCI::BAT::Mailbox::MailboxThread::MQTTConnect()
 {
-    if (m_isConnected)
-        return true;
+    // Only the first attempt of an outage is reported as info
+    auto level = m_backoff.count() ? spdlog::level::debug : spdlog::level::info;
+    GetLogger()->log(level, "Connecting to \"{}:{}\" MQTT Broker.", m_brokerAddress, m_brokerPort);
+    m_metrics.reconnects++;
+
+    Util::LockGuard janitor(m_mosqLock);
 
-    GetLogger()->info("Connecting to \"{}:{}\" MQTT Broker.", m_brokerAddress, m_brokerPort);
-    
     // Authentication
     if (!m_brokerUsername.empty())
     {
-        GetLogger()->info("Connecting with user \"{}\" using password: ", m_brokerUsername, m_brokerPassword.empty() ? "NO" : "YES");
+        GetLogger()->log(level, "Connecting with user \"{}\" using password: {}", m_brokerUsername, m_brokerPassword.empty() ? "NO" : "YES");
         username_pw_set(m_brokerUsername.c_str(), m_brokerPassword.empty() ? nullptr : m_brokerPassword.c_str());
     }
     else
@@ -121,61 +203,294 @@ bool SCI::BAT::Mailbox::MailboxThread::MQTTConnect()
         username_pw_set(nullptr, nullptr);
     }
 
-    // Connect
-    if (connect_async(m_brokerAddress.c_str(), m_brokerPort) == MOSQ_ERR_SUCCESS)
+    // Connect (completion is reported by on_connect)
+    auto result = connect_async(m_brokerAddress.c_str(), m_brokerPort);
+    if (result == MOSQ_ERR_SUCCESS)
+    {
+        m_state = ConnectionState::Connecting;
+        m_connectStarted = std::chrono::steady_clock::now();
+    }
+    else
+    {
+        GetLogger()->log(level, "Failed to connect to MQTT broker with code {}.", result);
+        janitor.Release();
+        ScheduleReconnect();
+    }
+}
+
+void SCI::BAT::Mailbox::MailboxThread::MQTTDisconnect()
+{
+    Util::LockGuard janitor(m_mosqLock);
+    if (m_state != ConnectionState::Disconnected)
+    {
+        m_state = ConnectionState::Disconnected;
+        disconnect();
+        m_mqttUpdated = false;
+        m_replayReset = true;
+        GetLogger()->info("Disconnected from MQTT broker.");
+    }
+}
+
+void SCI::BAT::Mailbox::MailboxThread::ScheduleReconnect()
+{
+    // Exponential backoff with jitter (the delay is randomized between half and the full backoff)
+    m_backoff = std::clamp(m_backoff * 2, m_reconnectMin, m_reconnectMax);
+    std::uniform_int_distribution<long long> jitter(m_backoff.count() / 2, m_backoff.count());
+    auto delay = std::chrono::milliseconds(jitter(m_random));
+    m_nextConnect = std::chrono::steady_clock::now() + delay;
+
+    GetLogger()->info("Retrying MQTT connection in {}ms.", delay.count());
+}
+
+void SCI::BAT::Mailbox::MailboxThread::OpenSpool()
+{
+    GetLogger()->info("Opening MQTT spool \"{}\" ({} bytes).", m_spoolFile.generic_string(), m_spoolSize);
+    ClearReplayInflight();
+    m_replayReset = true;
+    m_spoolOpenSize = m_spool.Open(m_spoolFile, m_spoolSize) ? m_spoolSize : 0;
+    m_metrics.spoolDepth = m_spool.Count();
+}
+
+void SCI::BAT::Mailbox::MailboxThread::ReplaySpool()
+{
+    using namespace std::chrono_literals;
+
+    Util::LockGuard janitor(m_mosqLock);
+
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration<double>(now - m_replayTime).count();
+    m_replayTime = now;
+
+    // Everything not acknowledged before the connection was lost is send again
+    if (m_replayReset)
+    {
+        ClearReplayInflight();
+        m_replayPosition = m_spool.Begin();
+        m_replayReset = false;
+    }
+
+    if (m_state != ConnectionState::Connected || m_spool.Empty())
+    {
+        m_replayBudget = 0.0;
+        return;
+    }
+
+    // Oldest messages may have been dropped while we were waiting
+    m_replayPosition = std::max(m_replayPosition, m_spool.Begin());
+
+    // Rate limit (burst of at most one second)
+    m_replayBudget = std::min(m_replayBudget + elapsed * m_replayRate, (double)m_replayRate);
+    while (m_replayBudget >= 1.0 && m_metrics.inflight < m_inflightWindow)
+    {
+        std::string topic, payload;
+        uint64_t next;
+        if (!m_spool.Read(m_replayPosition, topic, payload, next))
+            break;
+
+        int mid = 0;
+        auto result = publish(&mid, topic.c_str(), payload.length(), payload.data(), 1, true);
+        if (result != MOSQ_ERR_SUCCESS)
+        {
+            SCI_LOG_DEBUG(GetLogger(), "Failed to replay spooled MQTT message on topic \"{}\" error code {}.", topic, result);
+            m_metrics.publishFailures++;
+            break;
+        }
+
+        SCI_LOG_TRACE(GetLogger(), "Replayed spooled MQTT message on topic \"{}\" (Message ID: {}).", topic, mid);
+        m_replayInflight.push_back({ mid, next, std::chrono::steady_clock::now() });
+        m_metrics.messagesSent++;
+        m_metrics.bytesSent += payload.length();
+        m_metrics.inflight++;
+        m_replayPosition = next;
+        m_replayBudget -= 1.0;
+    }
+}
+
+void SCI::BAT::Mailbox::MailboxThread::Subscribe(const std::filesystem::path& subTopic, MessageHandler handler)
+{
+    Util::LockGuard janitor(m_subscriptionLock);
+    m_subscriptions.Insert(subTopic.generic_string(), std::move(handler));
+}
+
+void SCI::BAT::Mailbox::MailboxThread::Subscribe(const std::filesystem::path& subTopic, MessageChannel& channel)
+{
+    Subscribe(subTopic, [&channel](std::string_view subTopic, std::string_view payload) { channel.Send({ std::string(subTopic), std::string(payload) }); });
+}
+
+void SCI::BAT::Mailbox::MailboxThread::on_connect(int rc)
+{
+    if (rc == 0)
     {
-        GetLogger()->info("Successfully connected to MQTT broker.");
-        m_isConnected = true;
+        GetLogger()->info("Successfully connected to MQTT broker. {} messages in spool.", m_spool.Count());
+
+        Util::LockGuard janitor(m_mosqLock);
+        if (!m_pendingAcks.empty())
+        {
+            GetLogger()->warn("{} MQTT messages were not acknowledged before the connection was lost.", m_pendingAcks.size());
+            m_metrics.inflight -= m_pendingAcks.size();
+            m_pendingAcks.clear();
+        }
+        m_replayReset = true;
+        m_backoff = std::chrono::milliseconds(0);
+        m_state = ConnectionState::Connected;
 
-        // Subscribe to control topic
+        // Subscribe to control topic (subscriptions do not survive a new session)
         auto subscriptionPattern = m_baseTopic / "control" / "#";
         if (subscribe(nullptr, subscriptionPattern.generic_string().c_str()) == MOSQ_ERR_SUCCESS)
         {
-            // 
             GetLogger()->info("Successfully subsribed to {} MQTT topic.", subscriptionPattern.generic_string());
-            return true;
         }
         else
         {
             GetLogger()->error("Failed to subscribe to MQTT topic!");
-            MQTTDisconnect();
         }
     }
+    else
+    {
+        GetLogger()->warn("MQTT broker refused connection with code {}.", rc);
+        MQTTDisconnect();
+        ScheduleReconnect();
+    }
+}
 
-    return false;
+void SCI::BAT::Mailbox::MailboxThread::on_disconnect(int rc)
+{
+    m_metrics.disconnects++;
+
+    // Unexpected loss of the connection (MQTTDisconnect() sets the state before disconnecting)
+    Util::LockGuard janitor(m_mosqLock);
+    if (m_state != ConnectionState::Disconnected)
+    {
+        GetLogger()->warn("MQTT broker connection lost (Code: {}).", rc);
+        m_state = ConnectionState::Disconnected;
+        m_mqttUpdated = false;
+        m_replayReset = true;
+        janitor.Release();
+
+        ScheduleReconnect();
+    }
 }
 
-void SCI::BAT::Mailbox::MailboxThread::MQTTDisconnect()
+void SCI::BAT::Mailbox::MailboxThread::on_publish(int mid)
 {
-    if (m_isConnected)
+    m_mqttUpdated = true;
+
+    Util::LockGuard janitor(m_mosqLock);
+
+    // Directly published message
+    auto itPending = m_pendingAcks.find(mid);
+    if (itPending != m_pendingAcks.end())
     {
-        disconnect();
-        m_isConnected = false;
-        GetLogger()->info("Disconnected from MQTT broker.");
+        TrackAcknowledgement(itPending->second);
+        m_pendingAcks.erase(itPending);
+        return;
+    }
+
+    // Mark spooled message as delivered
+    for (auto& inflight : m_replayInflight)
+    {
+        if (inflight.mid == mid && !inflight.acked)
+        {
+            TrackAcknowledgement(inflight.sendTime);
+            inflight.acked = true;
+            break;
+        }
+    }
+
+    // Remove acknowledged messages from the spool (in order)
+    uint64_t commit = 0;
+    while (!m_replayInflight.empty() && m_replayInflight.front().acked)
+    {
+        commit = m_replayInflight.front().end;
+        m_replayInflight.pop_front();
+    }
+    if (commit)
+    {
+        m_spool.Commit(commit);
+        m_metrics.spoolDepth = m_spool.Count();
     }
 }
 
+void SCI::BAT::Mailbox::MailboxThread::ClearReplayInflight()
+{
+    // Acknowledged messages already left the in-flight window
+    m_metrics.inflight -= std::count_if(m_replayInflight.begin(), m_replayInflight.end(), [](const ReplayInflight& inflight) { return !inflight.acked; });
+    m_replayInflight.clear();
+}
+
+void SCI::BAT::Mailbox::MailboxThread::TrackAcknowledgement(std::chrono::steady_clock::time_point sendTime)
+{
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sendTime);
+    m_metrics.ackLatency.Record((uint64_t)latency.count());
+    m_metrics.inflight--;
+}
+
+void SCI::BAT::Mailbox::MailboxThread::SchedulePublishMetrics()
+{
+    Executor::Get().Cancel(m_metricsTask);
+    m_metricsTask = 0;
+    if (m_metricsInterval.count() > 0)
+    {
+        m_metricsTask = Executor::Get().Periodic(m_metricsInterval, std::bind(&MailboxThread::PublishMetrics, this), Executor::Priority::Low);
+    }
+}
+
+void SCI::BAT::Mailbox::MailboxThread::PublishMetrics()
+{
+    // Metrics are only of interest while live (never spooled)
+    if (m_state != ConnectionState::Connected)
+        return;
+
+    auto text = m_metrics.ToJson().dump();
+
+    Util::LockGuard janitor(m_mosqLock);
+    auto topic = (m_baseTopic / "sys" / "mailbox").generic_string();
+    auto result = publish(nullptr, topic.c_str(), text.length(), text.c_str(), 0, true);
+    if (result == MOSQ_ERR_SUCCESS)
+    {
+        m_metrics.messagesSent++;
+        m_metrics.bytesSent += text.length();
+    }
+    else
+    {
+        SCI_LOG_DEBUG(GetLogger(), "Failed to publish MQTT mailbox metrics error code {}.", result);
+        m_metrics.publishFailures++;
+    }
+}
+
+int SCI::BAT::Mailbox::MailboxThread::ResolveQoS(const std::string& subTopic)
+{
+    // Highest level of all matching rules
+    int qos = 0;
+    m_qosRules.Match(subTopic, [&](int level) { qos = std::max(qos, level); });
+    return qos;
+}
+
 void SCI::BAT::Mailbox::MailboxThread::on_message(const struct mosquitto_message* msg)
 {
-    const auto baseTopic = (m_baseTopic / "control").generic_string();
-    GetLogger()->trace("Received MQTT message on topic \"{}\" (Message ID: {}).", msg->topic, msg->mid);
+    SCI_LOG_TRACE(GetLogger(), "Received MQTT message on topic \"{}\" (Message ID: {}).", msg->topic, msg->mid);
 
-    // Extract message
-    std::string msgText;
-    msgText.assign((const char*)msg->payload, msg->payloadlen);
-    
-    // Extract topic
-    std::string topic = msg->topic;
+    // View message (no copy)
+    std::string_view topic(msg->topic);
+    std::string_view payload(static_cast<const char*>(msg->payload), msg->payloadlen);
+    m_metrics.messagesReceived++;
+    m_metrics.bytesReceived += payload.length();
 
-    auto cPos = topic.find(baseTopic);
-    if (cPos == 0)
+    // Extract topic
+    if (topic.length() > m_controlTopic.length() && topic.starts_with(m_controlTopic) && topic[m_controlTopic.length()] == '/')
     {
-        auto subTopic = topic.substr(cPos + baseTopic.length() + 1);
-        GetLogger()->trace("Decoded MQTT message for topic \"{}\": \"{}\".", subTopic, msgText);
+        auto subTopic = topic.substr(m_controlTopic.length() + 1);
+        SCI_LOG_TRACE(GetLogger(), "Decoded MQTT message for topic \"{}\": \"{}\".", subTopic, payload);
 
-        // Store message
-        Util::LockGuard janitor(m_lock);
-        m_mqttInbox[subTopic] = msgText;
+        // Dispatch message
+        Util::LockGuard janitor(m_subscriptionLock);
+        auto handlers = m_subscriptions.Match(subTopic, [&](const MessageHandler& handler) { handler(subTopic, payload); });
+        janitor.Release();
+
+        if (handlers == 0)
+        {
+            SCI_LOG_DEBUG(GetLogger(), "No subscriber for MQTT message on topic \"{}\". Message dropped.", subTopic);
+        }
     }
     else
     {
@@ -183,54 +498,65 @@ void SCI::BAT::Mailbox::MailboxThread::on_message(const struct mosquitto_message
     }
 }
 
-bool SCI::BAT::Mailbox::MailboxThread::GetMQTTMessage(const std::filesystem::path& subTopic, std::string& msgOut)
+void SCI::BAT::Mailbox::MailboxThread::OnConfigChange(const nlohmann::json& oldData, const nlohmann::json& newData)
 {
-    Util::LockGuard janitor(m_lock);
-    auto itFind = m_mqttInbox.find(subTopic.generic_string());
-    if (itFind != m_mqttInbox.end())
+    // Runs on the writing thread: Only flag what the change affects, the mailbox thread applies it
+    MailboxConfig oldConfig, newConfig;
+    std::string error;
+    Config::Schema<MailboxConfig>::FromJson(oldData, oldConfig, error);
+    Config::Schema<MailboxConfig>::FromJson(newData, newConfig, error);
+    if (Config::Schema<MailboxConfig>::Differs(oldConfig, newConfig, "broker") || Config::Schema<MailboxConfig>::Differs(oldConfig, newConfig, "basetopic"))
     {
-        msgOut = itFind->second;
-        m_mqttInbox.erase(itFind);
-        return true;
+        m_reconnectRequested = true;
     }
+    ConfigReload();
+}
 
-    return false;
+void SCI::BAT::Mailbox::MailboxThread::RegisterConfigSchema()
+{
+    Config::AuthenticateConfig::RegisterSchema<MailboxConfig>("mailbox");
 }
 
-void SCI::BAT::Mailbox::MailboxThread::LoadConfig()
+void SCI::BAT::Mailbox::MailboxThread::InsertDefaultConfig(Config::AuthenticateConfig::Transaction& defaults)
 {
-    // Assert config node existence
-    GetLogger()->debug("Asserting default config.");
-    Config::AuthenticateConfig::InsertData(
+    defaults.InsertDefaults<MailboxConfig>(
         "mailbox",
-        (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System,
+        (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System
+    );
+}
+
+void SCI::BAT::Mailbox::MailboxThread::LoadConfig()
+{
+    // Read current config (the defaults are inserted on startup, validated on write, nothing here can throw)
+    MailboxConfig config;
+    std::string error;
+    SCI_LOG_DEBUG(GetLogger(), "Reading config from db.");
+    if (Config::AuthenticateConfig::ReadTyped("mailbox", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, config, error))
+    {
+        m_brokerAddress = config.brokerAddress;
+        m_brokerUsername = config.brokerUsername;
+        m_brokerPassword = config.brokerPassword;
+        m_brokerPort = config.brokerPort;
+        m_spoolSize = config.spoolSize;
+        m_replayRate = config.replayRate;
+        m_reconnectMin = config.reconnectMin;
+        m_reconnectMax = std::max(config.reconnectMax, m_reconnectMin);
+        m_metricsInterval = config.metricsInterval;
+
+        TopicTrie<int> qosRules;
+        for (const auto& [filter, level] : config.qos)
         {
-            {
-                "broker",
-                {
-                    { "address", "localhost" },
-                    { "username", "" },
-                    { "password", "" },
-                    { "port", 1883 }
-                }
-            },
-            { "basetopic", "sci-bat" }
+            qosRules.Insert(filter, level);
         }
-        );
 
-    // Now read current config
-    nlohmann::json config;
-    GetLogger()->debug("Reading config from db.");
-    if (Config::AuthenticateConfig::ReadData("mailbox", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, config))
-    {
-        m_brokerAddress = config["broker"]["address"];
-        m_brokerUsername = config["broker"]["username"];
-        m_brokerPassword = config["broker"]["password"];
-        m_brokerPort = config["broker"]["port"];
-        m_baseTopic = config["basetopic"].get<std::string>();
+        Util::LockGuard janitor(m_mosqLock);
+        m_baseTopic = config.baseTopic;
+        m_controlTopic = (m_baseTopic / "control").generic_string();
+        m_inflightWindow = config.inflight;
+        m_qosRules = std::move(qosRules);
     }
     else
     {
-        GetLogger()->error("Failed to read config.");
+        GetLogger()->error("Failed to read config: {}", error);
     }
 }
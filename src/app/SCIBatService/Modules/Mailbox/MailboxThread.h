@@ -6,38 +6,86 @@
 #pragma once
 
 #include <Threading/Thread.h>
+#include <Threading/Executor.h>
+#include <Threading/Channel.h>
 #include <Config/AuthenticatedConfig.h>
+#include <Modules/Mailbox/MailboxConfig.h>
 #include <Modules/Webserver/HTTPAuthentication.h>
+#include <Modules/Mailbox/TopicTrie.h>
+#include <Modules/Mailbox/MessageSpool.h>
+#include <Modules/Mailbox/MailboxMetrics.h>
 
 #include <SCIUtil/SPDLogable.h>
 #include <SCIUtil/Concurrent/SpinLock.h>
+#include <SCIUtil/Concurrent/AdaptiveLock.h>
 #include <SCIUtil/Concurrent/LockGuard.h>
+#include <SCIUtil/Trace/Tracer.h>
 
 #include <mosquittopp.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <random>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace SCI::BAT::Mailbox
 {
     /*!
-     * @brief Stores all incoming MQTT message until they are process by the submodules
+     * @brief Provides publishing of MQTT messages and dispatches incoming messages to the subscribed submodules
     */
     class MailboxThread : public Thread, private mosqpp::mosquittopp, public Util::SPDLogable
     {
+        public:
+            /*!
+             * @brief Callback invoked for an incoming MQTT message.
+             * 
+             * Both views are only valid for the duration of the call. The callback is executed on the mailbox thread and must not block or publish.
+             * @param subTopic Topic relative to the control topic
+             * @param payload Message payload
+            */
+            using MessageHandler = std::function<void(std::string_view subTopic, std::string_view payload)>;
+
+            /*!
+             * @brief Incoming MQTT message (owning copy for asynchronous consumers)
+            */
+            struct Message
+            {
+                /*! Topic relative to the control topic */
+                std::string subTopic;
+                /*! Message payload */
+                std::string payload;
+            };
+            /*!
+             * @brief Channel delivering messages to a coroutine
+            */
+            using MessageChannel = Channel<Message>;
+
         public:
             /*!
              * @brief Creates a new instance
+             * @param spoolFile Path to the file that stores messages while the broker is unreachable
              * @param logger Logger to be used for thread
             */
-            inline MailboxThread(const std::shared_ptr<spdlog::logger>& logger = spdlog::default_logger())
+            inline MailboxThread(const std::filesystem::path& spoolFile, const std::shared_ptr<spdlog::logger>& logger = spdlog::default_logger()) :
+                m_spoolFile(spoolFile)
             {
                 s_mailbox = this;
 
+                SetName("mailbox");
                 SetLogger(logger);
+                m_spool.SetLogger(logger);
                 LoadConfig();
+                OpenSpool();
+
+                m_configWatch = Config::AuthenticateConfig::Watch("mailbox", [this](const std::string&, const nlohmann::json& oldData, const nlohmann::json& newData) { OnConfigChange(oldData, newData); });
             }
+            ~MailboxThread();
 
             int ThreadMain() override;
             void OnStop() override;
@@ -46,17 +94,26 @@ namespace SCI::BAT::Mailbox
              * @brief Publishes a MQTT message
              * @param subTopic (Sub)Topic to publish on
              * @param text Actual topic data
-             * @return True on success
+             * @param qos MQTT quality of service level (0 to 2). A negative value uses the level configured for the topic.
+             * @return True if the message was sent or stored in the spool for later delivery
+            */
+            bool Publish(const std::filesystem::path& subTopic, const std::string& text, int qos = -1);
+            /*!
+             * @brief Registers a handler for messages on a control (sub)topic
+             * @param subTopic (Sub)Topic filter relative to the control topic. May contain the MQTT wildcards '+' and '#'.
+             * @param handler Callback invoked for every matching message
             */
-            bool Publish(const std::filesystem::path& subTopic, const std::string& text);
+            void Subscribe(const std::filesystem::path& subTopic, MessageHandler handler);
             /*!
-             * @brief Retrive a MQTT message received prior
-             * @param subTopic Topic to find message on
-             * @param msgOut String to output message data on
-             * @return True if message was able to be retrieved
+             * @brief Registers a channel for messages on a control (sub)topic. A coroutine can await the messages via MessageChannel::Receive().
+             * @param subTopic (Sub)Topic filter relative to the control topic. May contain the MQTT wildcards '+' and '#'.
+             * @param channel Channel receiving a copy of every matching message. Must stay valid while the mailbox is running.
             */
-            bool GetMQTTMessage(const std::filesystem::path& subTopic, std::string& msgOut);
+            void Subscribe(const std::filesystem::path& subTopic, MessageChannel& channel);
 
+            void on_connect(int rc) override;
+            void on_disconnect(int rc) override;
+            void on_publish(int mid) override;
             void on_message(const struct mosquitto_message*) override;
 
             /*!
@@ -89,33 +146,129 @@ namespace SCI::BAT::Mailbox
              * @brief Gets the connection state of the static instance
              * @return True if connected
             */
-            static inline auto GetConnected()
+            static inline bool GetConnected()
             {
                 return s_mailbox->m_mqttUpdated;
             }
+            /*!
+             * @brief Gets the metrics of the static instance (all values can be read lock free)
+             * @return Reference to the metrics
+            */
+            static inline const MailboxMetrics& GetMetrics()
+            {
+                return s_mailbox->m_metrics;
+            }
+
+            /*!
+             * @brief Registers the schema of the config setting (writes and snapshot imports are validated against it).
+            */
+            static void RegisterConfigSchema();
+            /*!
+             * @brief Stages the insertion of the default config (only inserted if the setting does not exist).
+             * @param defaults Startup transaction of all defaults.
+            */
+            static void InsertDefaultConfig(Config::AuthenticateConfig::Transaction& defaults);
 
         private:
             void LoadConfig();
+            void OnConfigChange(const nlohmann::json& oldData, const nlohmann::json& newData);
 
-            bool MQTTConnect();
+            void MQTTConnect();
             void MQTTDisconnect();
+            void ScheduleReconnect();
+
+            void OpenSpool();
+            void ReplaySpool();
+
+            int ResolveQoS(const std::string& subTopic);
+            void SchedulePublishMetrics();
+            void PublishMetrics();
+            void ClearReplayInflight();
+            void TrackAcknowledgement(std::chrono::steady_clock::time_point sendTime);
+
+        private:
+            /*!
+             * @brief State of the broker connection
+            */
+            enum class ConnectionState
+            {
+                /*! No connection (waiting for the next attempt) */
+                Disconnected,
+                /*! Connection initiated, waiting for the broker to accept it */
+                Connecting,
+                /*! Broker accepted the connection */
+                Connected,
+            };
+
+            /*!
+             * @brief Spooled message that was send but not yet acknowledged by the broker
+            */
+            struct ReplayInflight
+            {
+                /*! Message id assigned by mosquitto */
+                int mid;
+                /*! Spool position after the message */
+                uint64_t end;
+                /*! Time the message was handed to mosquitto */
+                std::chrono::steady_clock::time_point sendTime;
+                /*! PUBACK received */
+                bool acked = false;
+            };
 
         private:
             static MailboxThread* s_mailbox;
 
             Util::SpinLock m_lock;
-            Util::SpinLock m_mosqLock;
+            Util::AdaptiveLock m_mosqLock{ "mailbox.mosquitto" };
+            Util::SpinLock m_subscriptionLock;
+
+            std::atomic_bool m_mqttUpdated = false;
 
-            bool m_mqttUpdated = false;
+            // Config subscription (only broker and topic changes require a new connection)
+            uint64_t m_configWatch = 0;
+            std::atomic_bool m_reconnectRequested = false;
 
-            std::unordered_map<std::string, std::string> m_mqttInbox;
+            TopicTrie<MessageHandler> m_subscriptions;
+            std::string m_controlTopic = "sci-bat/control";
 
             std::string m_brokerAddress = "localhost";
             std::string m_brokerUsername = "";
             std::string m_brokerPassword = "";
             int m_brokerPort = 1883;
+            // Guarded by m_mosqLock (together with m_controlTopic)
             std::filesystem::path m_baseTopic = "sci-bat";
-            bool m_isConnected = false;
-            bool m_hasError = false;
+
+            // Connection
+            static constexpr std::chrono::seconds ConnectTimeout = std::chrono::seconds(15);
+            std::atomic<ConnectionState> m_state = ConnectionState::Disconnected;
+            std::chrono::steady_clock::time_point m_connectStarted;
+            std::chrono::steady_clock::time_point m_nextConnect;
+            std::chrono::milliseconds m_reconnectMin = std::chrono::milliseconds(1000);
+            std::chrono::milliseconds m_reconnectMax = std::chrono::milliseconds(60000);
+            std::chrono::milliseconds m_backoff = std::chrono::milliseconds(0);
+            std::mt19937 m_random = std::mt19937(std::random_device()());
+
+            // Delivery tracking
+            TopicTrie<int> m_qosRules;
+            size_t m_inflightWindow = 20;
+            std::unordered_map<int, std::chrono::steady_clock::time_point> m_pendingAcks;
+
+            // Store and forward
+            std::filesystem::path m_spoolFile;
+            MessageSpool m_spool;
+            size_t m_spoolSize = 16 * 1024 * 1024;
+            size_t m_spoolOpenSize = 0;
+            unsigned int m_replayRate = 50;
+            double m_replayBudget = 0.0;
+            bool m_replayReset = true;
+            uint64_t m_replayPosition = 0;
+            std::deque<ReplayInflight> m_replayInflight;
+            std::chrono::steady_clock::time_point m_replayTime = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::time_point m_spoolFlushTime = std::chrono::steady_clock::now();
+
+            // Metrics
+            MailboxMetrics m_metrics;
+            std::chrono::milliseconds m_metricsInterval = std::chrono::milliseconds(10000);
+            Executor::TaskId m_metricsTask = 0;
     };
 }
@@ -0,0 +1,298 @@
+#include "MessageSpool.h"
+
+#if defined(SCI_WINDOWS)
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(SCI_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+SCI::BAT::Mailbox::MessageSpool::~MessageSpool()
+{
+    Close();
+}
+
+bool SCI::BAT::Mailbox::MessageSpool::Open(const std::filesystem::path& file, size_t capacity)
+{
+    Close();
+
+    Util::LockGuard janitor(m_lock);
+    if (!Map(file, sizeof(Header) + capacity))
+    {
+        GetLogger()->error("Failed to map MQTT spool file \"{}\".", file.generic_string());
+        return false;
+    }
+
+    // Validate existing content
+    if (memcmp(m_header->magic, Magic, sizeof(Magic)) != 0 || m_header->version != Version || m_header->capacity != capacity ||
+        m_header->head < m_header->tail || m_header->head - m_header->tail > capacity)
+    {
+        GetLogger()->info("Initializing MQTT spool \"{}\" ({} bytes).", file.generic_string(), capacity);
+        Initialize(capacity);
+    }
+    else if (!CheckRecords())
+    {
+        GetLogger()->error("MQTT spool \"{}\" is corrupted. Discarding {} messages.", file.generic_string(), m_header->count);
+        Initialize(capacity);
+    }
+    else if (m_header->count)
+    {
+        GetLogger()->info("MQTT spool \"{}\" contains {} undelivered messages.", file.generic_string(), m_header->count);
+    }
+
+    return true;
+}
+
+void SCI::BAT::Mailbox::MessageSpool::Close()
+{
+    Util::LockGuard janitor(m_lock);
+    Unmap();
+}
+
+bool SCI::BAT::Mailbox::MessageSpool::Push(std::string_view topic, std::string_view payload)
+{
+    RecordHeader record{ (uint32_t)topic.length(), (uint32_t)payload.length() };
+    const uint64_t recordSize = sizeof(RecordHeader) + topic.length() + payload.length();
+
+    Util::LockGuard janitor(m_lock);
+    if (!m_header || recordSize > m_header->capacity)
+    {
+        return false;
+    }
+
+    // Make room
+    size_t dropped = 0;
+    while (m_header->capacity - (m_header->head - m_header->tail) < recordSize)
+    {
+        // A corrupted record discards the whole content (the loop ends with an empty spool)
+        if (!DropOldest())
+            break;
+        dropped++;
+    }
+    if (dropped)
+    {
+        // Only report the first overflow of an outage
+        GetLogger()->log(m_overflowReported ? spdlog::level::debug : spdlog::level::warn, "MQTT spool full. Dropped {} oldest messages.", dropped);
+        m_overflowReported = true;
+    }
+
+    // Write data before publishing the new head
+    CopyIn(m_header->head, &record, sizeof(RecordHeader));
+    CopyIn(m_header->head + sizeof(RecordHeader), topic.data(), topic.length());
+    CopyIn(m_header->head + sizeof(RecordHeader) + topic.length(), payload.data(), payload.length());
+    m_header->head += recordSize;
+    m_header->count++;
+
+    return true;
+}
+
+bool SCI::BAT::Mailbox::MessageSpool::Read(uint64_t position, std::string& topicOut, std::string& payloadOut, uint64_t& nextOut)
+{
+    Util::LockGuard janitor(m_lock);
+    if (!m_header || position < m_header->tail || position >= m_header->head)
+    {
+        return false;
+    }
+
+    RecordHeader record;
+    if (!ReadRecord(position, record))
+    {
+        Discard(position);
+        return false;
+    }
+    topicOut.resize(record.topicLength);
+    payloadOut.resize(record.payloadLength);
+    CopyOut(position + sizeof(RecordHeader), topicOut.data(), record.topicLength);
+    CopyOut(position + sizeof(RecordHeader) + record.topicLength, payloadOut.data(), record.payloadLength);
+    nextOut = position + sizeof(RecordHeader) + record.topicLength + record.payloadLength;
+
+    return true;
+}
+
+void SCI::BAT::Mailbox::MessageSpool::Commit(uint64_t position)
+{
+    Util::LockGuard janitor(m_lock);
+    if (m_header)
+    {
+        // Records need to be removed one by one to keep the count valid
+        while (m_header->tail < position && m_header->tail < m_header->head)
+        {
+            if (!DropOldest())
+                break;
+        }
+        if (m_header->count == 0)
+        {
+            m_overflowReported = false;
+        }
+    }
+}
+
+void SCI::BAT::Mailbox::MessageSpool::Flush()
+{
+    Util::LockGuard janitor(m_lock);
+    if (m_header)
+    {
+        #if defined(SCI_WINDOWS)
+        FlushViewOfFile(m_header, m_mappedSize);
+        #elif defined(SCI_LINUX)
+        msync(m_header, m_mappedSize, MS_ASYNC);
+        #endif
+    }
+}
+
+void SCI::BAT::Mailbox::MessageSpool::CopyIn(uint64_t position, const void* data, size_t size)
+{
+    const size_t offset = position % m_header->capacity;
+    const size_t first = std::min<size_t>(size, m_header->capacity - offset);
+    memcpy(m_data + offset, data, first);
+    memcpy(m_data, (const uint8_t*)data + first, size - first);
+}
+
+void SCI::BAT::Mailbox::MessageSpool::CopyOut(uint64_t position, void* data, size_t size) const
+{
+    const size_t offset = position % m_header->capacity;
+    const size_t first = std::min<size_t>(size, m_header->capacity - offset);
+    memcpy(data, m_data + offset, first);
+    memcpy((uint8_t*)data + first, m_data, size - first);
+}
+
+bool SCI::BAT::Mailbox::MessageSpool::ReadRecord(uint64_t position, RecordHeader& record) const
+{
+    // The lengths come from the file. A record must end at or before the head
+    if (m_header->head - position < sizeof(RecordHeader))
+    {
+        return false;
+    }
+    CopyOut(position, &record, sizeof(RecordHeader));
+    return (uint64_t)record.topicLength + record.payloadLength <= m_header->head - position - sizeof(RecordHeader);
+}
+
+bool SCI::BAT::Mailbox::MessageSpool::DropOldest()
+{
+    RecordHeader record;
+    if (!ReadRecord(m_header->tail, record))
+    {
+        Discard(m_header->tail);
+        return false;
+    }
+    m_header->tail += sizeof(RecordHeader) + record.topicLength + record.payloadLength;
+    m_header->count--;
+    return true;
+}
+
+bool SCI::BAT::Mailbox::MessageSpool::CheckRecords() const
+{
+    uint64_t count = 0;
+    for (uint64_t position = m_header->tail; position < m_header->head; count++)
+    {
+        RecordHeader record;
+        if (!ReadRecord(position, record))
+        {
+            return false;
+        }
+        position += sizeof(RecordHeader) + record.topicLength + record.payloadLength;
+    }
+    return count == m_header->count;
+}
+
+void SCI::BAT::Mailbox::MessageSpool::Initialize(size_t capacity)
+{
+    memset(m_header, 0, sizeof(Header));
+    memcpy(m_header->magic, Magic, sizeof(Magic));
+    m_header->version = Version;
+    m_header->capacity = capacity;
+}
+
+void SCI::BAT::Mailbox::MessageSpool::Discard(uint64_t position)
+{
+    // Positions stay monotonic (readers hold positions up to the head)
+    GetLogger()->error("MQTT spool record at position {} is corrupted. Discarding {} messages.", position, m_header->count);
+    m_header->tail = m_header->head;
+    m_header->count = 0;
+}
+
+bool SCI::BAT::Mailbox::MessageSpool::Map(const std::filesystem::path& file, size_t fileSize)
+{
+    #if defined(SCI_WINDOWS)
+    m_fileHandle = CreateFileW(file.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        m_fileHandle = nullptr;
+        return false;
+    }
+
+    m_mappingHandle = CreateFileMappingW(m_fileHandle, nullptr, PAGE_READWRITE, (DWORD)((uint64_t)fileSize >> 32), (DWORD)(fileSize & 0xFFFFFFFF), nullptr);
+    void* view = m_mappingHandle ? MapViewOfFile(m_mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, fileSize) : nullptr;
+    if (!view)
+    {
+        Unmap();
+        return false;
+    }
+    #elif defined(SCI_LINUX)
+    m_fileDescriptor = open(file.c_str(), O_RDWR | O_CREAT, 0600);
+    if (m_fileDescriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(m_fileDescriptor, &fileStat) != 0 || ((size_t)fileStat.st_size != fileSize && ftruncate(m_fileDescriptor, fileSize) != 0))
+    {
+        Unmap();
+        return false;
+    }
+
+    void* view = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0);
+    if (view == MAP_FAILED)
+    {
+        Unmap();
+        return false;
+    }
+    #else
+    static_assert(false, "Not implemented!");
+    #endif
+
+    m_mappedSize = fileSize;
+    m_header = (Header*)view;
+    m_data = (uint8_t*)view + sizeof(Header);
+    return true;
+}
+
+void SCI::BAT::Mailbox::MessageSpool::Unmap()
+{
+    #if defined(SCI_WINDOWS)
+    if (m_header)
+    {
+        FlushViewOfFile(m_header, m_mappedSize);
+        UnmapViewOfFile(m_header);
+    }
+    if (m_mappingHandle)
+    {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle)
+    {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+    #elif defined(SCI_LINUX)
+    if (m_header)
+    {
+        msync(m_header, m_mappedSize, MS_SYNC);
+        munmap(m_header, m_mappedSize);
+    }
+    if (m_fileDescriptor >= 0)
+    {
+        close(m_fileDescriptor);
+        m_fileDescriptor = -1;
+    }
+    #endif
+
+    m_header = nullptr;
+    m_data = nullptr;
+    m_mappedSize = 0;
+}
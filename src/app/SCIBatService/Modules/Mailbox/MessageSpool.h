@@ -0,0 +1,177 @@
+/*!
+ * @file MessageSpool.h
+ * @brief Persistent (memory mapped) ring buffer for MQTT messages.
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <SCIUtil/SPDLogable.h>
+#include <SCIUtil/Concurrent/AdaptiveLock.h>
+#include <SCIUtil/Concurrent/LockGuard.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <filesystem>
+
+namespace SCI::BAT::Mailbox
+{
+    /*!
+     * @brief Ring buffer of MQTT messages stored in a memory mapped file.
+     *
+     * Messages are appended at the head and removed from the tail once they have been delivered. Positions are monotonic byte offsets
+     * (they never wrap), the physical location in the file is the position modulo the capacity. When the spool is full the oldest
+     * messages are dropped to make room for new ones. The content survives a restart of the service. A record that does not fit between
+ * its position and the head (torn write, corrupt file) discards all stored messages.
+    */
+    class MessageSpool : public Util::SPDLogable
+    {
+        private:
+            /*!
+             * @brief Header stored at the beginning of the spool file.
+            */
+            struct Header
+            {
+                char magic[8];
+                uint32_t version;
+                uint32_t reserved;
+                uint64_t capacity;
+                uint64_t head;
+                uint64_t tail;
+                uint64_t count;
+            };
+
+            /*!
+             * @brief Header of every record in the ring.
+            */
+            struct RecordHeader
+            {
+                uint32_t topicLength;
+                uint32_t payloadLength;
+            };
+
+        public:
+            MessageSpool() = default;
+            MessageSpool(const MessageSpool&) = delete;
+            MessageSpool(MessageSpool&&) noexcept = delete;
+            ~MessageSpool();
+
+            MessageSpool& operator=(const MessageSpool&) = delete;
+            MessageSpool& operator=(MessageSpool&&) noexcept = delete;
+
+            /*!
+             * @brief Opens (or creates) the spool file.
+             *
+             * Existing content is kept when the capacity matches. Otherwise the file is reinitialized.
+             * @param file Path to the spool file.
+             * @param capacity Size of the message area in bytes.
+             * @return True if the spool is usable.
+            */
+            bool Open(const std::filesystem::path& file, size_t capacity);
+            /*!
+             * @brief Flushes and closes the spool file.
+            */
+            void Close();
+
+            /*!
+             * @brief Appends a message to the spool. Drops the oldest messages if required.
+             * @param topic Full topic of the message.
+             * @param payload Payload of the message.
+             * @return True if the message was stored.
+            */
+            bool Push(std::string_view topic, std::string_view payload);
+            /*!
+             * @brief Reads the message at a position.
+             * @param position Position of the message (Begin() or the next position of a prior Read()).
+             * @param topicOut Topic of the message.
+             * @param payloadOut Payload of the message.
+             * @param nextOut Position of the following message.
+             * @return True if a message was read. False if position is not inside the spool.
+            */
+            bool Read(uint64_t position, std::string& topicOut, std::string& payloadOut, uint64_t& nextOut);
+            /*!
+             * @brief Removes all messages before a position (marks them as delivered).
+             * @param position Position up to which the messages are removed.
+            */
+            void Commit(uint64_t position);
+            /*!
+             * @brief Writes modified pages back to disk.
+            */
+            void Flush();
+
+            /*!
+             * @brief Checks if the spool is open.
+             * @return True if the spool can be used.
+            */
+            inline bool IsOpen() const noexcept
+            {
+                return m_header != nullptr;
+            }
+            /*!
+             * @brief Position of the oldest message.
+             * @return Tail position.
+            */
+            inline uint64_t Begin()
+            {
+                Util::LockGuard janitor(m_lock);
+                return m_header ? m_header->tail : 0;
+            }
+            /*!
+             * @brief Position after the newest message.
+             * @return Head position.
+            */
+            inline uint64_t End()
+            {
+                Util::LockGuard janitor(m_lock);
+                return m_header ? m_header->head : 0;
+            }
+            /*!
+             * @brief Number of messages stored.
+             * @return Message count.
+            */
+            inline uint64_t Count()
+            {
+                Util::LockGuard janitor(m_lock);
+                return m_header ? m_header->count : 0;
+            }
+            /*!
+             * @brief Checks if no message is stored.
+             * @return True if empty.
+            */
+            inline bool Empty()
+            {
+                return Count() == 0;
+            }
+
+        private:
+            void CopyIn(uint64_t position, const void* data, size_t size);
+            void CopyOut(uint64_t position, void* data, size_t size) const;
+            bool ReadRecord(uint64_t position, RecordHeader& record) const;
+            bool DropOldest();
+            bool CheckRecords() const;
+            void Initialize(size_t capacity);
+            void Discard(uint64_t position);
+
+            bool Map(const std::filesystem::path& file, size_t fileSize);
+            void Unmap();
+
+        private:
+            static constexpr char Magic[8] = { 'S', 'C', 'I', 'S', 'P', 'O', 'O', 'L' };
+            static constexpr uint32_t Version = 1;
+
+            Util::AdaptiveLock m_lock{ "mailbox.spool" };
+
+            Header* m_header = nullptr;
+            uint8_t* m_data = nullptr;
+            size_t m_mappedSize = 0;
+            bool m_overflowReported = false;
+
+            #if defined(SCI_WINDOWS)
+            void* m_fileHandle = nullptr;
+            void* m_mappingHandle = nullptr;
+            #elif defined(SCI_LINUX)
+            int m_fileDescriptor = -1;
+            #endif
+    };
+}
@@ -0,0 +1,149 @@
+/*!
+ * @file TopicTrie.h
+ * @brief Prefix tree for matching MQTT topics against subscriptions.
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <type_traits>
+
+namespace SCI::BAT::Mailbox
+{
+    /*!
+     * @brief Prefix tree that maps MQTT topic filters to values.
+     *
+     * Filters are split into their levels once when inserted. Matching walks the tree on a view of the incoming topic and does not allocate.
+     * The MQTT wildcards '+' (exactly one level) and '#' (all remaining levels) are supported.
+     * @tparam T Type of the values stored per filter.
+    */
+    template<typename T>
+    class TopicTrie
+    {
+        private:
+            /*!
+             * @brief Single level of the tree.
+            */
+            struct Node
+            {
+                std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+                std::vector<T> values;
+            };
+
+        public:
+            /*!
+             * @brief Inserts a value for a topic filter.
+             * @param filter Topic filter (levels separated by '/', may contain '+' and '#').
+             * @param value Value to be stored for the filter.
+            */
+            void Insert(std::string_view filter, T value)
+            {
+                Node* node = &m_root;
+                while (true)
+                {
+                    auto level = filter.substr(0, filter.find('/'));
+                    auto itChild = node->children.find(level);
+                    if (itChild == node->children.end())
+                    {
+                        itChild = node->children.emplace(std::string(level), std::make_unique<Node>()).first;
+                    }
+                    node = itChild->second.get();
+
+                    if (level.length() == filter.length())
+                        break;
+                    filter.remove_prefix(level.length() + 1);
+                }
+
+                node->values.push_back(std::move(value));
+            }
+
+            /*!
+             * @brief Calls f for every value whose filter matches the topic.
+             * @tparam F Type of the callback. Invoked as f(const T&).
+             * @param topic Topic to be matched.
+             * @param f Callback function.
+             * @return Number of values that matched.
+            */
+            template<typename F, typename = std::enable_if_t<std::is_invocable_v<F, const T&>>>
+            size_t Match(std::string_view topic, F&& f) const
+            {
+                return MatchLevel(m_root, topic, f);
+            }
+
+            /*!
+             * @brief Removes all filters.
+            */
+            void Clear()
+            {
+                m_root.children.clear();
+                m_root.values.clear();
+            }
+
+            /*!
+             * @brief Checks if no filter is stored.
+             * @return True if the tree is empty.
+            */
+            inline bool Empty() const noexcept
+            {
+                return m_root.children.empty();
+            }
+
+        private:
+            template<typename F>
+            static size_t MatchLevel(const Node& node, std::string_view topic, F& f)
+            {
+                size_t matches = 0;
+
+                // Multi level wildcard matches everything below (including the parent level itself)
+                auto itMulti = node.children.find(std::string_view("#"));
+                if (itMulti != node.children.end())
+                {
+                    matches += Invoke(*itMulti->second, f);
+                }
+
+                auto level = topic.substr(0, topic.find('/'));
+                bool last = level.length() == topic.length();
+                auto rest = last ? std::string_view() : topic.substr(level.length() + 1);
+
+                // Exact and single level wildcard
+                for (auto key : { level, std::string_view("+") })
+                {
+                    auto itChild = node.children.find(key);
+                    if (itChild != node.children.end())
+                    {
+                        matches += last ? MatchEnd(*itChild->second, f) : MatchLevel(*itChild->second, rest, f);
+                    }
+                }
+
+                return matches;
+            }
+
+            template<typename F>
+            static size_t MatchEnd(const Node& node, F& f)
+            {
+                // "a/#" also matches "a"
+                size_t matches = Invoke(node, f);
+                auto itMulti = node.children.find(std::string_view("#"));
+                if (itMulti != node.children.end())
+                {
+                    matches += Invoke(*itMulti->second, f);
+                }
+                return matches;
+            }
+
+            template<typename F>
+            static size_t Invoke(const Node& node, F& f)
+            {
+                for (const auto& value : node.values)
+                    f(value);
+                return node.values.size();
+            }
+
+        private:
+            Node m_root;
+    };
+}
@@ -14,10 +14,13 @@
 
 #include <Modules/Webserver/Controllers/Api/StatusController.h>
 #include <Modules/Webserver/Controllers/Api/SettingsController.h>
+#include <Modules/Webserver/Controllers/Api/SettingsBatchController.h>
 #include <Modules/Webserver/Controllers/Api/SerialListController.h>
 #include <Modules/Webserver/Controllers/Api/UsermodController.h>
 #include <Modules/Webserver/Controllers/Api/SysStatusController.h>
 #include <Modules/Webserver/Controllers/Api/SysctrlController.h>
+#include <Modules/Webserver/Controllers/Api/TraceController.h>
+#include <Modules/Webserver/Controllers/Api/KeysController.h>
 
 void SCI::BAT::SCIBatWebserver::RegisterControllers()
 {
@@ -38,8 +41,11 @@ void SCI::BAT::SCIBatWebserver::RegisterControllers()
     // API
     RegisterController<Webserver::Controllers::StatusController>("/api/status");
     RegisterController<Webserver::Controllers::SettingsController>("/api/setting/(\\w+)"); /* /api/settings/<setting> */
+    RegisterController<Webserver::Controllers::SettingsBatchController>("/api/settings");
     RegisterController<Webserver::Controllers::SerialListController>("/api/serial/list");
     RegisterController<Webserver::Controllers::UsermodController>("/api/usermod/(\\w+)/(\\w+)"); /* /api/usermod/<operation>/<username> */
     RegisterController<Webserver::Controllers::SysStatusController>("/api/sysstatus");
     RegisterController<Webserver::Controllers::SysctrlController>("/api/sysctrl/(\\w+)"); /* /api/sysctrl/<operation> */
+    RegisterController<Webserver::Controllers::TraceController>("/api/trace");
+    RegisterController<Webserver::Controllers::KeysController>("/api/keys");
 }
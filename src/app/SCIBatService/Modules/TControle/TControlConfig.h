@@ -0,0 +1,30 @@
+/*!
+ * @file TControlConfig.h
+ * @brief Typed configuration of the temperature control module (config key "tcontrole").
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <Config/Schema.h>
+
+#include <string>
+#include <tuple>
+
+namespace SCI::BAT::TControle
+{
+    /*!
+     * @brief Relay card and fan settings.
+    */
+    struct TControlConfig
+    {
+        /*! Serial device of the relay card */
+        std::string serialDevice = "/dev/tty";
+        /*! Time in ms the fans keep running after the temperature dropped */
+        unsigned int cooloffTime = 5000;
+
+        static constexpr auto Fields = std::make_tuple(
+            Config::MakeField("serial.device", &TControlConfig::serialDevice),
+            Config::MakeField("cooloff-time", &TControlConfig::cooloffTime, 0, 3600000)
+        );
+    };
+}
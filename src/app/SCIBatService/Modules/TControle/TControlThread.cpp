@@ -2,17 +2,17 @@
 
 SCI::BAT::TControle::TControlThread* SCI::BAT::TControle::TControlThread::s_instance = nullptr;
 
-int SCI::BAT::TControle::TControlThread::ThreadMain()
+SCI::BAT::Task<int> SCI::BAT::TControle::TControlThread::CoMain()
 {
     using namespace std::chrono_literals;
 
-    // Load from config
-    LoadConfig();
+    // Mode requests are received concurrently on this thread
+    Spawn(ReceiveModeMessages());
 
     // Get a list of serial devices and print them
     auto serialDevices = ListSerialDevices();
     for (const auto& device : serialDevices)
-        GetLogger()->debug("Found serial device \"{}\".", device);
+        SCI_LOG_DEBUG(GetLogger(), "Found serial device \"{}\".", device);
 
     // Abort when no serial is available
     m_deviceAvailable = std::find(serialDevices.begin(), serialDevices.end(), m_serialDevice) != serialDevices.end();
@@ -25,6 +25,8 @@ int SCI::BAT::TControle::TControlThread::ThreadMain()
     // Loop
     while (!StopRequested())
     {
+        ThreadProfile::Iteration iteration(GetProfile());
+
         // Get timestamp
         auto now = std::chrono::system_clock::now();
 
@@ -32,97 +34,64 @@ int SCI::BAT::TControle::TControlThread::ThreadMain()
         if (ConfigReloadRequested())
         {
             GetLogger()->info("Config change requested!");
+            bool deviceChanged = m_deviceChanged.exchange(false);
 
-            // Save state
-            GetLogger()->info("Going info save state...");
-            m_watchdogExpires = now;
-            m_watchdogTriped = false;
-            SetRelais(0, false);
-            SetRelais(1, false);
-            SetRelais(2, false);
-            SetRelais(3, false);
+            // Save state (only when switching the relais card)
+            if (deviceChanged)
+            {
+                GetLogger()->info("Going info save state...");
+                m_watchdogExpires = now;
+                m_watchdogTriped = false;
+                co_await SetRelais(0, false);
+                co_await SetRelais(1, false);
+                co_await SetRelais(2, false);
+                co_await SetRelais(3, false);
+            }
 
             // Reload config
             GetLogger()->info("Reloading config.");
             LoadConfig();
 
-            // List devices
-            serialDevices = ListSerialDevices();
-            for (const auto& device : serialDevices)
-                GetLogger()->debug("Found serial device \"{}\".", device);
-
-            // Validate serial devices
-            if (serialDevices.size() == 0)
-                throw std::runtime_error("No serial devices present! TControle will terminate!");
-
-            // Report
-            m_deviceAvailable = std::find(serialDevices.begin(), serialDevices.end(), m_serialDevice) != serialDevices.end();
-            GetLogger()->info("Using serial device \"{}\". Currently detected: {}", m_serialDevice, m_deviceAvailable ? "YES" : "NO");
+            if (deviceChanged)
+            {
+                // List devices
+                serialDevices = ListSerialDevices();
+                for (const auto& device : serialDevices)
+                    SCI_LOG_DEBUG(GetLogger(), "Found serial device \"{}\".", device);
+
+                // Validate serial devices
+                if (serialDevices.size() == 0)
+                    throw std::runtime_error("No serial devices present! TControle will terminate!");
+
+                // Report
+                m_deviceAvailable = std::find(serialDevices.begin(), serialDevices.end(), m_serialDevice) != serialDevices.end();
+                GetLogger()->info("Using serial device \"{}\". Currently detected: {}", m_serialDevice, m_deviceAvailable ? "YES" : "NO");
+            }
 
             // Finished
             GetLogger()->info("Finished config reload.");
             DoneConfigChange();
         }
 
-        // Check for new MQTT message
-        std::string msg;
-        if (m_mailbox.GetMQTTMessage(std::filesystem::path("tcontrol") / "mode", msg))
+        // Apply mode requested via MQTT
+        int requestedMode = m_requestedMode.exchange(NoModeRequest);
+        if (requestedMode != NoModeRequest)
         {
-            // Set active mode
-            bool msgValid = true;
-            if (msg == "off" || msg == "0")
-            {
-                // Set fan off time
-                if (m_mode == OperationMode::HeatingPwr1 || m_mode == OperationMode::HeatingPwr2 || m_mode == OperationMode::HeatingPwr3)
-                {
-                    GetLogger()->info("Applying fan cooloff time");
-                    m_fanOffTime = now + 1ms * m_fanCooloffTime;
-                }
-
-                m_modeApplyed = m_mode == OperationMode::Off;
-                m_mode = OperationMode::Off;
-            }
-            else if (msg == "cooling" || msg == "-1")
-            {
-                // Set fan off time
-                if (m_mode == OperationMode::HeatingPwr1 || m_mode == OperationMode::HeatingPwr2 || m_mode == OperationMode::HeatingPwr3)
-                {
-                    GetLogger()->info("Applying fan cooloff time");
-                    m_fanOffTime = now + 1ms * m_fanCooloffTime;
-                }
+            auto mode = (OperationMode)requestedMode;
 
-                m_modeApplyed = m_mode == OperationMode::Cooling;
-                m_mode = OperationMode::Cooling;
-            }
-            else if (msg == "heating" || msg == "h1" || msg == "1")
+            // Set fan off time when heating stops
+            if ((mode == OperationMode::Off || mode == OperationMode::Cooling) && 
+                (m_mode == OperationMode::HeatingPwr1 || m_mode == OperationMode::HeatingPwr2 || m_mode == OperationMode::HeatingPwr3))
             {
-                m_modeApplyed = m_mode == OperationMode::HeatingPwr1;
-                m_mode = OperationMode::HeatingPwr1;
-            }
-            else if (msg == "h2" || msg == "2")
-            {
-                m_modeApplyed = m_mode == OperationMode::HeatingPwr2;
-                m_mode = OperationMode::HeatingPwr2;
-            }
-            else if (msg == "h3" || msg == "3")
-            {
-                m_modeApplyed = m_mode == OperationMode::HeatingPwr3;
-                m_mode = OperationMode::HeatingPwr3;
-            }
-            else
-            {
-                msgValid = false;
+                GetLogger()->info("Applying fan cooloff time");
+                m_fanOffTime = now + 1ms * m_fanCooloffTime;
             }
 
-            if (msgValid)
-            {
-                // Set watchdog
-                m_watchdogExpires = now + 15min;
-            }
-            else
-            {
-                GetLogger()->warn("Can't interpret MQTT value \"{}\"", msg);
-            }
+            m_modeApplyed = m_mode == mode;
+            m_mode = mode;
+
+            // Set watchdog
+            m_watchdogExpires = now + 15min;
         }
 
         // Watchdog (value sequential write required)
@@ -138,32 +107,32 @@ int SCI::BAT::TControle::TControlThread::ThreadMain()
                 switch (m_mode)
                 {
                     case OperationMode::Off:
-                        SetRelais(0, false);
-                        SetRelais(2, false);
-                        SetRelais(3, false);
+                        co_await SetRelais(0, false);
+                        co_await SetRelais(2, false);
+                        co_await SetRelais(3, false);
                         break;
                     case OperationMode::Cooling:
-                        SetRelais(0, true);
-                        SetRelais(2, false);
-                        SetRelais(3, false);
+                        co_await SetRelais(0, true);
+                        co_await SetRelais(2, false);
+                        co_await SetRelais(3, false);
                         break;
                     case OperationMode::HeatingPwr1:
-                        SetRelais(0, false);
-                        SetRelais(1, true);
-                        SetRelais(2, true);
-                        SetRelais(3, false);
+                        co_await SetRelais(0, false);
+                        co_await SetRelais(1, true);
+                        co_await SetRelais(2, true);
+                        co_await SetRelais(3, false);
                         break;
                     case OperationMode::HeatingPwr2:
-                        SetRelais(0, false);
-                        SetRelais(1, true);
-                        SetRelais(2, false);
-                        SetRelais(3, true);
+                        co_await SetRelais(0, false);
+                        co_await SetRelais(1, true);
+                        co_await SetRelais(2, false);
+                        co_await SetRelais(3, true);
                         break;
                     case OperationMode::HeatingPwr3:
-                        SetRelais(0, false);
-                        SetRelais(1, true);
-                        SetRelais(2, true);
-                        SetRelais(3, true);
+                        co_await SetRelais(0, false);
+                        co_await SetRelais(1, true);
+                        co_await SetRelais(2, true);
+                        co_await SetRelais(3, true);
                         break;
                 }
 
@@ -176,9 +145,9 @@ int SCI::BAT::TControle::TControlThread::ThreadMain()
             if (!m_watchdogTriped)
             {
                 // All relays off
-                SetRelais(0, false);
-                SetRelais(2, false);
-                SetRelais(3, false);
+                co_await SetRelais(0, false);
+                co_await SetRelais(2, false);
+                co_await SetRelais(3, false);
 
                 m_watchdogTriped = true;
             }
@@ -188,7 +157,7 @@ int SCI::BAT::TControle::TControlThread::ThreadMain()
         if (m_mode != OperationMode::HeatingPwr1 && m_mode != OperationMode::HeatingPwr2 && m_mode != OperationMode::HeatingPwr3 &&  now > m_fanOffTime && m_relaisStates[1] == true)
         {
             GetLogger()->info("Fan cooldown reached!");
-            SetRelais(1, false);
+            co_await SetRelais(1, false);
         }
 
         // Report current state as MQTT messages
@@ -201,81 +170,122 @@ int SCI::BAT::TControle::TControlThread::ThreadMain()
             m_mailbox.Publish(topic.str(), value.str());
         }
 
-        // Delay
-        std::this_thread::sleep_for(1s);
+        // Delay (a new mode request will wake us early)
+        iteration.End();
+        co_await Sleep(1s);
     }
 
     // All relays off
-    SetRelais(0, false);
-    SetRelais(1, false);
-    SetRelais(2, false);
-    SetRelais(3, false);
+    co_await SetRelais(0, false);
+    co_await SetRelais(1, false);
+    co_await SetRelais(2, false);
+    co_await SetRelais(3, false);
 
-    return true;
+    m_modeMessages.Close();
+    co_return 0;
 }
 
-void SCI::BAT::TControle::TControlThread::LoadConfig()
+SCI::BAT::Task<void> SCI::BAT::TControle::TControlThread::ReceiveModeMessages()
+{
+    while (auto message = co_await m_modeMessages.Receive(GetEventLoop()))
+    {
+        OnModeMessage(message->payload);
+    }
+}
+
+void SCI::BAT::TControle::TControlThread::OnModeMessage(std::string_view payload)
 {
-    // Assert config node existence
-    GetLogger()->debug("Asserting default config.");
-    Config::AuthenticateConfig::InsertData(
+    OperationMode mode;
+    if (payload == "off" || payload == "0")
+        mode = OperationMode::Off;
+    else if (payload == "cooling" || payload == "-1")
+        mode = OperationMode::Cooling;
+    else if (payload == "heating" || payload == "h1" || payload == "1")
+        mode = OperationMode::HeatingPwr1;
+    else if (payload == "h2" || payload == "2")
+        mode = OperationMode::HeatingPwr2;
+    else if (payload == "h3" || payload == "3")
+        mode = OperationMode::HeatingPwr3;
+    else
+    {
+        GetLogger()->warn("Can't interpret MQTT value \"{}\"", payload);
+        return;
+    }
+
+    m_requestedMode = (int)mode;
+    Wake();
+}
+
+SCI::BAT::TControle::TControlThread::~TControlThread()
+{
+    Config::AuthenticateConfig::Unwatch(m_configWatch);
+}
+
+void SCI::BAT::TControle::TControlThread::OnConfigChange(const nlohmann::json& oldData, const nlohmann::json& newData)
+{
+    // Runs on the writing thread: Only flag what the change affects, the coroutine applies it
+    TControlConfig oldConfig, newConfig;
+    std::string error;
+    Config::Schema<TControlConfig>::FromJson(oldData, oldConfig, error);
+    Config::Schema<TControlConfig>::FromJson(newData, newConfig, error);
+    if (Config::Schema<TControlConfig>::Differs(oldConfig, newConfig, "serial"))
+    {
+        m_deviceChanged = true;
+    }
+    ConfigReload();
+}
+
+void SCI::BAT::TControle::TControlThread::RegisterConfigSchema()
+{
+    Config::AuthenticateConfig::RegisterSchema<TControlConfig>("tcontrole");
+}
+
+void SCI::BAT::TControle::TControlThread::InsertDefaultConfig(Config::AuthenticateConfig::Transaction& defaults)
+{
+    defaults.InsertDefaults<TControlConfig>(
         "tcontrole",
-        (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System,
-        {
-            {
-                "serial",
-                {
-                    { "device", "/dev/tty" },
-                }
-            },
-            { "cooloff-time", 5000 }
-        }
+        (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System
     );
+}
 
-    // Now read current config
-    nlohmann::json config;
-    GetLogger()->debug("Reading config from db.");
-    if (Config::AuthenticateConfig::ReadData("tcontrole", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, config))
+void SCI::BAT::TControle::TControlThread::LoadConfig()
+{
+    // Read current config (the defaults are inserted on startup, see InsertDefaultConfig)
+    TControlConfig config;
+    std::string error;
+    SCI_LOG_DEBUG(GetLogger(), "Reading config from db.");
+    if (Config::AuthenticateConfig::ReadTyped("tcontrole", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, config, error))
     {
-        m_serialDevice = config["serial"]["device"];
-        m_fanCooloffTime = config["cooloff-time"];
+        m_serialDevice = config.serialDevice;
+        m_fanCooloffTime = config.cooloffTime;
     }
     else
     {
-        GetLogger()->error("Failed to read config.");
+        GetLogger()->error("Failed to read config: {}", error);
     }
 }
 
-bool SCI::BAT::TControle::TControlThread::SetRelais(unsigned int index, bool on)
+SCI::BAT::Task<bool> SCI::BAT::TControle::TControlThread::SetRelais(unsigned int index, bool on)
 {
     using namespace std::chrono_literals;
 
-    GetLogger()->debug("Setting relais {} to {}", index, on);
+    SCI_LOG_DEBUG(GetLogger(), "Setting relais {} to {}", index, on);
     if (index < 4)
     {
-        if (on)
+        if (SerialSend(on ? m_bytesOn[index] : m_bytesOff[index], m_bytesWordSize))
         {
-            if (SerialSend(m_bytesOn[index], m_bytesWordSize))
-            {
-                m_relaisStates[index] = true;
-                std::this_thread::sleep_for(50ms);
-                return true;
-            }
-        }
-        else
-        {
-            if (SerialSend(m_bytesOff[index], m_bytesWordSize))
-            {
-                m_relaisStates[index] = false;
-                std::this_thread::sleep_for(50ms);
-                return true;
-            }
+            m_relaisStates[index] = on;
+
+            // The relay card needs a pause between two commands (a wake request must not shorten it)
+            auto pauseEnd = std::chrono::steady_clock::now() + 50ms;
+            while (co_await Sleep(pauseEnd - std::chrono::steady_clock::now()));
+            co_return true;
         }
     }
 
     // Error 
     GetLogger()->error("Failed setting relais {} to {}", index, on);
-    return false;
+    co_return false;
 }
 
 bool SCI::BAT::TControle::TControlThread::SerialSend(const void* data, unsigned int byts)
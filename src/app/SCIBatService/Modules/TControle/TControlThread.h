@@ -5,8 +5,9 @@
  */
 #pragma once
 
-#include <Threading/Thread.h>
+#include <Threading/CoThread.h>
 #include <Config/AuthenticatedConfig.h>
+#include <Modules/TControle/TControlConfig.h>
 #include <Modules/Mailbox/MailboxThread.h>
 #include <Modules/Webserver/HTTPAuthentication.h>
 
@@ -16,7 +17,10 @@
 #include <fmt/format.h>
 #include <SCIUtil/SPDLogable.h>
 
+#include <atomic>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <vector>
 #include <filesystem>
@@ -24,9 +28,9 @@
 namespace SCI::BAT::TControle
 {
     /*!
-     * @brief Thread implementing temperature control
+     * @brief Thread implementing temperature control (coroutine based)
     */
-    class TControlThread : public Thread, public Util::SPDLogable
+    class TControlThread : public CoThread, public Util::SPDLogable
     {
         public:
             /*!
@@ -66,12 +70,17 @@ namespace SCI::BAT::TControle
             TControlThread(Mailbox::MailboxThread& mailbox, const std::shared_ptr<spdlog::logger>& logger = spdlog::default_logger()) :
                 m_mailbox(mailbox)
             {
+                SetName("tcontrol");
                 SetLogger(logger);
                 s_instance = this;
                 LoadConfig();
+                m_configWatch = Config::AuthenticateConfig::Watch("tcontrole", [this](const std::string&, const nlohmann::json& oldData, const nlohmann::json& newData) { OnConfigChange(oldData, newData); });
+
+                m_mailbox.Subscribe(std::filesystem::path("tcontrol") / "mode", m_modeMessages);
             }
+            ~TControlThread();
 
-            int ThreadMain() override;
+            Task<int> CoMain() override;
 
             /*!
              * @brief Retrive the status of the static instance
@@ -129,10 +138,23 @@ namespace SCI::BAT::TControle
             */
             static std::vector<std::string> ListSerialDevices();
 
+            /*!
+             * @brief Registers the schema of the config setting (writes and snapshot imports are validated against it).
+            */
+            static void RegisterConfigSchema();
+            /*!
+             * @brief Stages the insertion of the default config (only inserted if the setting does not exist).
+             * @param defaults Startup transaction of all defaults.
+            */
+            static void InsertDefaultConfig(Config::AuthenticateConfig::Transaction& defaults);
+
         private:
             void LoadConfig();
+            void OnConfigChange(const nlohmann::json& oldData, const nlohmann::json& newData);
+            Task<void> ReceiveModeMessages();
+            void OnModeMessage(std::string_view payload);
 
-            bool SetRelais(unsigned int index, bool on);
+            Task<bool> SetRelais(unsigned int index, bool on);
             bool SerialSend(const void* data, unsigned int byts);
 
         private:
@@ -144,6 +166,10 @@ namespace SCI::BAT::TControle
             std::string m_serialDevice = "/dev/tty";
             unsigned int m_fanCooloffTime = 5000;
 
+            // Config subscription (only a new serial device requires the relais to be reset)
+            uint64_t m_configWatch = 0;
+            std::atomic_bool m_deviceChanged = false;
+
             // Device available
             bool m_deviceAvailable = false;
             bool m_lastCommandOk = false;
@@ -155,6 +181,8 @@ namespace SCI::BAT::TControle
             SerialStopBits m_serialStopBits = SERIAL_STOPBITS_1;
 
             // Operation
+            static constexpr int NoModeRequest = std::numeric_limits<int>::min();
+            std::atomic<int> m_requestedMode = NoModeRequest;
             OperationMode m_mode = OperationMode::Off;
             std::chrono::system_clock::time_point m_fanOffTime = std::chrono::system_clock::now();
             bool m_modeApplyed = false;
@@ -166,6 +194,7 @@ namespace SCI::BAT::TControle
 
             // Ref to mailbox
             Mailbox::MailboxThread& m_mailbox;
+            Mailbox::MailboxThread::MessageChannel m_modeMessages;
 
             // Constant data (controlling the relais)
             const unsigned int m_bytesWordSize = 8;
@@ -0,0 +1,34 @@
+#include "KeysController.h"
+
+void SCI::BAT::Webserver::Controllers::KeysController::OnGet(const httplib::Request& request, httplib::Response& response)
+{
+    nlohmann::json data;
+    auto user = HTTPAuthentication::Session(request, response, data);
+    if (user && (int)user.permissionLevel >= (int)HTTPUser::PermissionLevel::Admin)
+    {
+        size_t limit = DefaultLimit;
+        if (request.has_param("limit"))
+        {
+            auto limitStr = request.get_param_value("limit");
+            auto result = std::from_chars(limitStr.data(), limitStr.data() + limitStr.length(), limit);
+            if (result.ec != std::errc() || limit == 0)
+            {
+                response.status = 400;
+                return;
+            }
+            limit = std::min(limit, MaxLimit);
+        }
+
+        std::vector<std::string> keys;
+        bool more = Config::AuthenticateConfig::ListKeys(request.get_param_value("prefix"), (int)user.permissionLevel, request.get_param_value("after"), limit, keys);
+
+        nlohmann::json jsonResponse;
+        jsonResponse["keys"] = keys;
+        jsonResponse["next"] = more && !keys.empty() ? nlohmann::json(keys.back()) : nlohmann::json(nullptr);
+        RenderJSON(response, jsonResponse);
+    }
+    else
+    {
+        response.status = 401;
+    }
+}
@@ -0,0 +1,37 @@
+/*!
+ * @file KeysController.h
+ * @brief Controller for listing config keys
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <Modules/Webserver/HTTPController.h>
+#include <Modules/Webserver/HTTPAuthentication.h>
+
+#include <Config/AuthenticatedConfig.h>
+
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <vector>
+
+namespace SCI::BAT::Webserver::Controllers
+{
+    /*!
+     * @brief Controller for listing config keys by prefix (paged, ascending)
+     * 
+     * Query parameters: "prefix" (for example "user."), "after" (value of "next" from the previous page) and "limit" (default 50, at most 500).
+     * Only keys readable by the user are listed.
+    */
+    class KeysController : public HTTPController
+    {
+        public:
+            /*! Keys per page if no limit is given */
+            static constexpr size_t DefaultLimit = 50;
+            /*! Largest page */
+            static constexpr size_t MaxLimit = 500;
+
+        public:
+            void OnGet(const httplib::Request& request, httplib::Response& response) override;
+    };
+}
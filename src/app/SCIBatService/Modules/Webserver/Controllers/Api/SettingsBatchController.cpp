@@ -0,0 +1,74 @@
+#include "SettingsBatchController.h"
+
+void SCI::BAT::Webserver::Controllers::SettingsBatchController::OnPost(const httplib::Request& request, httplib::Response& response)
+{
+    nlohmann::json data;
+    auto user = HTTPAuthentication::Session(request, response, data);
+    if (user)
+    {
+        nlohmann::json settings = nlohmann::json::parse(request.body, nullptr, false);
+        if (!settings.is_object() || settings.empty())
+        {
+            RenderJSON(response, { { "error", "expected an object of settings" } });
+            response.status = 400;
+            return;
+        }
+
+        // Stage all writes (validation and permissions) before anything is written
+        Config::AuthenticateConfig::Transaction transaction((int)user.permissionLevel);
+        for (const auto& [key, config] : settings.items())
+        {
+            if (!IsSettingName(key))
+            {
+                GetLogger()->warn("Audit: User \"{}\" tried to write config node \"{}\" through the settings batch.", user.name, key);
+                RenderJSON(response, { { "error", fmt::format("{}: not a setting name", key) } });
+                response.status = 400;
+                return;
+            }
+
+            std::string error;
+            if (!Config::AuthenticateConfig::Validate(key, config, error))
+            {
+                GetLogger()->warn("Audit: User \"{}\" wrote invalid data to config node \"{}\" ({}).", user.name, key, error);
+                RenderJSON(response, { { "error", fmt::format("{}: {}", key, error) } });
+                response.status = 400;
+                return;
+            }
+            if (!transaction.Write(key, config))
+            {
+                GetLogger()->warn("Audit: User \"{}\" failed writing to config node \"{}\".", user.name, key);
+                response.status = 401;
+                return;
+            }
+        }
+
+        switch (transaction.Commit())
+        {
+            case Config::AuthenticateConfig::Transaction::CommitResult::Committed:
+                GetLogger()->info("Audit: User \"{}\" wrote to config nodes \"{}\".", user.name, fmt::join(transaction.GetKeys(), "\", \""));
+                break;
+            case Config::AuthenticateConfig::Transaction::CommitResult::Denied:
+                GetLogger()->warn("Audit: User \"{}\" lost the permission to write the settings batch before it was committed.", user.name);
+                response.status = 401;
+                break;
+            case Config::AuthenticateConfig::Transaction::CommitResult::Conflict:
+                GetLogger()->warn("Settings batch of user \"{}\" conflicts with a concurrent change.", user.name);
+                response.status = 409;
+                break;
+            case Config::AuthenticateConfig::Transaction::CommitResult::Failed:
+                GetLogger()->error("Failed to commit settings of user \"{}\".", user.name);
+                response.status = 500;
+                break;
+        }
+    }
+    else
+    {
+        response.status = 401;
+    }
+}
+
+bool SCI::BAT::Webserver::Controllers::SettingsBatchController::IsSettingName(std::string_view key)
+{
+    // Same as the \w+ of the single setting route (dotted keys like "user.admin" are rejected)
+    return !key.empty() && std::all_of(key.begin(), key.end(), [](char c) { return std::isalnum((unsigned char)c) || c == '_'; });
+}
@@ -0,0 +1,41 @@
+/*!
+ * @file SettingsBatchController.h
+ * @brief Controller for writing multiple settings at once
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <Modules/Webserver/HTTPController.h>
+#include <Modules/Webserver/HTTPAuthentication.h>
+
+#include <Config/AuthenticatedConfig.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace SCI::BAT::Webserver::Controllers
+{
+    /*!
+     * @brief Controller for writing multiple settings at once
+     * 
+     * The body is an object mapping setting names to their new data. All settings are written in one transaction
+     * (all or nothing) and the affected modules reload once. Only top level settings can be written (same names as /api/setting/(\w+)),
+     * user records are changed through the user management.
+    */
+    class SettingsBatchController : public HTTPController
+    {
+        public:
+            void OnPost(const httplib::Request& request, httplib::Response& response) override;
+
+        private:
+            /*!
+             * @brief Checks if a key is a top level setting name (letters, digits and underscores).
+             * @param key Name of the setting.
+             * @return True if the key can be written by this controller.
+            */
+            static bool IsSettingName(std::string_view key);
+    };
+}
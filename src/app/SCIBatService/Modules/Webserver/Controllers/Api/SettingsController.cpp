@@ -27,10 +27,16 @@ void SCI::BAT::Webserver::Controllers::SettingsController::OnPost(const httplib:
     if (user)
     {
         nlohmann::json config = nlohmann::json::parse(request.body);
-        if (Config::AuthenticateConfig::WriteData(setting.str(), (int)user.permissionLevel, config))
+        std::string error;
+        if (!Config::AuthenticateConfig::Validate(setting.str(), config, error))
+        {
+            GetLogger()->warn("Audit: User \"{}\" wrote invalid data to config node \"{}\" ({}).", user.name, setting.str(), error);
+            RenderJSON(response, { { "error", error } });
+            response.status = 400;
+        }
+        else if (Config::AuthenticateConfig::WriteData(setting.str(), (int)user.permissionLevel, config))
         {
             GetLogger()->info("Audit: User \"{}\" wrote to config node \"{}\".", user.name, setting.str());
-            Gateway::GatewayThread::ReloadAllModules();
         }
         else
         {
@@ -20,10 +20,55 @@ void SCI::BAT::Webserver::Controllers::SysStatusController::OnGet(const httplib:
         bool gatewaySmaUpdated = Gateway::GatewayThread::GetSMAUpdateOk();
         auto mailboxConnection = Mailbox::MailboxThread::GetConnectionString();
         bool mailboxConnected = Mailbox::MailboxThread::GetConnected();
+        auto mailboxMetrics = Mailbox::MailboxThread::GetMetrics().ToJson();
         auto tcontroleDevice = TControle::TControlThread::GetSerialDevice();
         bool tcontroleDeviceAvailable = TControle::TControlThread::GetDeviceAvailable();
         bool tcontroleLastCmdOk = TControle::TControlThread::GetLastCommandOk();
 
+        // Get executor load
+        auto executorStats = Executor::Get().GetStats();
+
+        // Get lock contention
+        nlohmann::json locksJson = nlohmann::json::object();
+        Util::AdaptiveLock::ForEach([&](const Util::AdaptiveLock& lock)
+            {
+                auto stats = lock.GetStats();
+                locksJson[lock.GetName()] = {
+                    { "acquisitions", stats.acquisitions },
+                    { "contended", stats.contended },
+                    { "parked", stats.parked },
+                    { "holdTimeNs", {
+                        { "mean", stats.holdTime.Mean() },
+                        { "p50", stats.holdTime.Percentile(0.5) },
+                        { "p99", stats.holdTime.Percentile(0.99) },
+                        { "max", stats.holdTime.max },
+                    }},
+                };
+            });
+
+        // Get thread profiles (threads without a name are listed by their tid)
+        nlohmann::json profilesJson = nlohmann::json::array();
+        ThreadProfile::ForEach([&](const ThreadProfile& profile)
+            {
+                auto snapshot = profile.Read();
+                profilesJson.push_back({
+                    { "name", snapshot.name.empty() ? fmt::format("tid-{}", snapshot.tid) : snapshot.name },
+                    { "tid", snapshot.tid },
+                    { "running", snapshot.running },
+                    { "cpuTimeMs", snapshot.cpuTime / 1000000 },
+                    { "voluntarySwitches", snapshot.voluntarySwitches },
+                    { "involuntarySwitches", snapshot.involuntarySwitches },
+                    { "lockWaitUs", snapshot.lockWait / 1000 },
+                    { "iterations", snapshot.iterations },
+                    { "iterationTimeUs", {
+                        { "mean", snapshot.iterationTime.Mean() },
+                        { "p50", snapshot.iterationTime.Percentile(0.5) },
+                        { "p99", snapshot.iterationTime.Percentile(0.99) },
+                        { "max", snapshot.iterationTime.max },
+                    }},
+                });
+            });
+
         // Build json
         nlohmann::json sysStatusJson = {
             { "threads", {
@@ -49,13 +94,23 @@ void SCI::BAT::Webserver::Controllers::SysStatusController::OnGet(const httplib:
                 { "mailbox", {
                     { "connection", mailboxConnection },
                     { "connected", mailboxConnected },
+                    { "metrics", mailboxMetrics },
                 }},
                 { "tcontrol", {
                     { "device", tcontroleDevice },
                     { "deviceAvailable", tcontroleDeviceAvailable },
                     { "lastCmdOk", tcontroleLastCmdOk},
                 }},
-            }}
+            }},
+            { "executor", {
+                { "workers", executorStats.workers },
+                { "executed", executorStats.executed },
+                { "stolen", executorStats.stolen },
+                { "failed", executorStats.failed },
+                { "timers", executorStats.timers },
+            }},
+            { "locks", locksJson },
+            { "profiles", profilesJson },
         };
 
         // Render data
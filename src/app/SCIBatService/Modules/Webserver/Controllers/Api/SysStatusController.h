@@ -5,6 +5,8 @@
  */
 #pragma once
 
+#include <Threading/Executor.h>
+#include <Threading/ThreadProfile.h>
 #include <Modules/Webserver/HTTPController.h>
 #include <Modules/Webserver/HTTPAuthentication.h>
 
@@ -12,6 +14,8 @@
 #include <Modules/Mailbox/MailboxThread.h>
 #include <Modules/TControle/TControlThread.h>
 
+#include <SCIUtil/Concurrent/AdaptiveLock.h>
+
 #include <fmt/format.h>
 
 namespace SCI::BAT::Webserver::Controllers
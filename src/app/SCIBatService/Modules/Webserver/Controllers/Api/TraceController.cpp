@@ -0,0 +1,44 @@
+#include "TraceController.h"
+
+void SCI::BAT::Webserver::Controllers::TraceController::OnGet(const httplib::Request& request, httplib::Response& response)
+{
+    nlohmann::json data;
+    auto user = HTTPAuthentication::Session(request, response, data);
+    if (user && (int)user.permissionLevel >= (int)HTTPUser::PermissionLevel::Admin)
+    {
+        // Export
+        response.set_header("Content-Disposition", "attachment; filename=\"sci-bat-trace.json\"");
+        RenderMIME(response, Util::Tracer::Export(), "application/json");
+    }
+    else
+    {
+        response.status = 401;
+    }
+}
+
+void SCI::BAT::Webserver::Controllers::TraceController::OnPost(const httplib::Request& request, httplib::Response& response)
+{
+    nlohmann::json data;
+    auto user = HTTPAuthentication::Session(request, response, data);
+    if (user && (int)user.permissionLevel >= (int)HTTPUser::PermissionLevel::Admin)
+    {
+        // Switch recording
+        if (request.has_param("enabled"))
+        {
+            bool enabled = request.get_param_value("enabled") != "0";
+            GetLogger()->info("Tracing {} by user \"{}\"", enabled ? "enabled" : "disabled", user.name);
+            Util::Tracer::SetEnabled(enabled);
+        }
+        if (request.get_param_value("clear") == "1")
+        {
+            GetLogger()->info("Trace cleared by user \"{}\"", user.name);
+            Util::Tracer::Clear();
+        }
+
+        RenderJSON(response, { { "enabled", Util::Tracer::IsEnabled() } });
+    }
+    else
+    {
+        response.status = 401;
+    }
+}
@@ -0,0 +1,26 @@
+/*!
+ * @file TraceController.h
+ * @brief Controller for exporting the in process trace
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <Modules/Webserver/HTTPController.h>
+#include <Modules/Webserver/HTTPAuthentication.h>
+
+#include <SCIUtil/Trace/Tracer.h>
+
+namespace SCI::BAT::Webserver::Controllers
+{
+    /*!
+     * @brief Controller for exporting the in process trace (Chrome trace JSON, open in chrome://tracing or ui.perfetto.dev)
+     * 
+     * GET exports the recorded events. POST parameters: "enabled=0|1" switches recording, "clear=1" discards the recorded events.
+    */
+    class TraceController : public HTTPController
+    {
+        public:
+            void OnGet(const httplib::Request& request, httplib::Response& response) override;
+            void OnPost(const httplib::Request& request, httplib::Response& response) override;
+    };
+}
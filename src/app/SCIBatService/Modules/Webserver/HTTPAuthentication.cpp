@@ -5,9 +5,8 @@ SCI::BAT::Webserver::HTTPAuthentication SCI::BAT::Webserver::HTTPAuthentication:
 SCI::BAT::Webserver::HTTPUser SCI::BAT::Webserver::HTTPAuthentication::Session(const httplib::Request& request, httplib::Response& response, inja::json& data)
 {
     using namespace std::chrono_literals;
-    s_instance.DoCleanup();
 
-    s_instance.GetLogger()->trace("Session authentication requested");
+    SCI_LOG_TRACE(s_instance.GetLogger(), "Session authentication requested");
 
     // Quick and dirty session
     HTTPUser user;
@@ -21,39 +20,53 @@ SCI::BAT::Webserver::HTTPUser SCI::BAT::Webserver::HTTPAuthentication::Session(c
             std::string cookieValue = cookieHeader.substr(eqPos + 1);
             if (cookieName == "SCI_BAT_AUTH")
             {
-                s_instance.GetLogger()->trace("Begining session authentication for session id {}", cookieValue);
+                SCI_LOG_TRACE(s_instance.GetLogger(), "Begining session authentication for session id {}", cookieValue);
 
-                Util::LockGuard janitor(s_instance.m_lock); // Begin critical section
+                Util::SharedLockGuard janitor(s_instance.m_lock); // Begin critical section (read only)
 
+                auto now = std::chrono::system_clock::now();
                 auto itSession = s_instance.m_sessions.find(cookieValue);
                 if (itSession != s_instance.m_sessions.end())
                 {
                     auto& sessionData = itSession->second;
-                    if (sessionData.sourceAddress == request.remote_addr && sessionData.validUntil >= std::chrono::system_clock::now())
+                    if (sessionData.sourceAddress == request.remote_addr && sessionData.validUntil >= now)
                     {
-                        sessionData.validUntil = std::chrono::system_clock::now() + 15min; // Re validate
                         user.sid = cookieValue;
                         user.name = sessionData.userName;
                         user.permissionLevel = sessionData.permissionLevel;
-                        s_instance.GetLogger()->debug("Session {} authentication for user {} sucessfull.", cookieValue, sessionData.userName);
+                        bool revalidate = sessionData.validUntil - now < 14min; // Extending the session requires exclusive access (at most once a minute)
+                        janitor.Release(); // End critical section
+                        SCI_LOG_DEBUG(s_instance.GetLogger(), "Session {} authentication for user {} sucessfull.", cookieValue, user.name);
+
+                        if (revalidate)
+                        {
+                            Util::LockGuard exclusiveJanitor(s_instance.m_lock); // Begin critical section
+                            itSession = s_instance.m_sessions.find(cookieValue);
+                            if (itSession != s_instance.m_sessions.end())
+                            {
+                                itSession->second.validUntil = now + 15min; // Re validate
+                            }
+                        }
                     }
                     else
                     {
                         if (sessionData.sourceAddress != request.remote_addr) s_instance.GetLogger()->warn("Potential security risk. {} tried to access session {} owned by {}", request.remote_addr, cookieValue, sessionData.sourceAddress);
-                        if(sessionData.validUntil < std::chrono::system_clock::now()) s_instance.GetLogger()->debug("Session {} for user {} expired.", cookieValue, sessionData.userName);
+                        if (sessionData.validUntil < now) SCI_LOG_DEBUG(s_instance.GetLogger(), "Session {} for user {} expired.", cookieValue, sessionData.userName);
+                        janitor.Release(); // End critical section
 
-                        s_instance.m_sessions.erase(itSession); // Delete
+                        Util::LockGuard exclusiveJanitor(s_instance.m_lock); // Begin critical section
+                        s_instance.m_sessions.erase(cookieValue); // Delete
                     }
                 }
                 else
                 {
-                    s_instance.GetLogger()->debug("Invalid session {} requested", cookieValue);
+                    SCI_LOG_DEBUG(s_instance.GetLogger(), "Invalid session {} requested", cookieValue);
                 }
             }
         }
     }
 
-    s_instance.GetLogger()->trace("Session authentication finished");
+    SCI_LOG_TRACE(s_instance.GetLogger(), "Session authentication finished");
 
     // 15 + 1 Minutes valid cookie (REFRESH)
     if(!user.sid.empty()) 
@@ -68,9 +81,7 @@ SCI::BAT::Webserver::HTTPUser SCI::BAT::Webserver::HTTPAuthentication::Session(c
 
 void SCI::BAT::Webserver::HTTPAuthentication::Destroy(HTTPUser& user)
 {
-    s_instance.DoCleanup();
-
-    s_instance.GetLogger()->trace("Begining destruction of session id {}", user.sid);
+    SCI_LOG_TRACE(s_instance.GetLogger(), "Begining destruction of session id {}", user.sid);
     if (!user.sid.empty())
     {
         Util::LockGuard janitor(s_instance.m_lock); // Begin critical section
@@ -81,20 +92,19 @@ void SCI::BAT::Webserver::HTTPAuthentication::Destroy(HTTPUser& user)
         }
         janitor.Release(); // End critical section
 
-        s_instance.GetLogger()->debug("Destroyed session {} for user {}", user.sid, user.name);
+        SCI_LOG_DEBUG(s_instance.GetLogger(), "Destroyed session {} for user {}", user.sid, user.name);
 
         // Change user
         user.sid = "";
         user.permissionLevel = HTTPUser::PermissionLevel::Unauthenticated;
     }
 
-    s_instance.GetLogger()->trace("Session destruction finished");
+    SCI_LOG_TRACE(s_instance.GetLogger(), "Session destruction finished");
 }
 
 SCI::BAT::Webserver::HTTPUser SCI::BAT::Webserver::HTTPAuthentication::Create(const httplib::Request& request, httplib::Response& response, inja::json& data, std::string username, HTTPUser::PermissionLevel permissionLevel)
 {
     using namespace std::chrono_literals;
-    s_instance.DoCleanup();
 
     HTTPUser user;
     user.sid = uuids::to_string(uuids::uuid_system_generator{}());
@@ -118,45 +128,22 @@ SCI::BAT::Webserver::HTTPUser SCI::BAT::Webserver::HTTPAuthentication::Create(co
     data["USERNAME"] = user.name;
     data["AUTH_LEVEL"] = (int)user.permissionLevel;
 
-    s_instance.GetLogger()->debug("Created session {} for user {} {}", user.sid, user.name, request.remote_addr);
+    SCI_LOG_DEBUG(s_instance.GetLogger(), "Created session {} for user {} {}", user.sid, user.name, request.remote_addr);
 
     return user;
 }
 
-void SCI::BAT::Webserver::HTTPAuthentication::DoCleanup()
+void SCI::BAT::Webserver::HTTPAuthentication::Cleanup()
 {
-    using namespace std::chrono_literals;
-
     auto now = std::chrono::system_clock::now();
-    if (now - m_lastCleanup > 15min)
-    {
-        Util::LockGuard janitor(s_instance.m_lock); // Begin critical section
-        if (now - m_lastCleanup > 15min)
-        {
-            GetLogger()->info("Cleanup of invalid sessions initiated");
-
-            m_lastCleanup = now;
 
-            // Find outdated sessions
-            std::vector<std::string> invalidSessions;
-            for (auto it : m_sessions)
-            {
-                if (it.second.validUntil < now)
-                {
-                    invalidSessions.push_back(it.first);
-                }
-            }
-
-            // Remove outdated sessions
-            for (auto it : invalidSessions)
-            {
-                m_sessions.erase(m_sessions.find(it));
-            }
-
-            GetLogger()->info("Succesfully remove {} invalid sessions.", invalidSessions.size());
-        }
+    Util::LockGuard janitor(s_instance.m_lock); // Begin critical section
+    size_t sessionCount = s_instance.m_sessions.size();
+    std::erase_if(s_instance.m_sessions, [&](const auto& session) { return session.second.validUntil < now; });
+    size_t removedCount = sessionCount - s_instance.m_sessions.size();
+    janitor.Release(); // End critical section
 
-    }
+    SCI_LOG_DEBUG(s_instance.GetLogger(), "Cleanup of invalid sessions removed {} sessions.", removedCount);
 }
 
 std::string SCI::BAT::Webserver::HTTPAuthentication::HashPassword(const std::string& password)
@@ -9,7 +9,8 @@
 
 #include <SCIUtil/SPDLogable.h>
 #include <SCIUtil/Exception.h>
-#include <SCIUtil/Concurrent/SpinLock.h>
+#include <SCIUtil/Concurrent/SharedAdaptiveLock.h>
+#include <SCIUtil/Concurrent/SharedLockGuard.h>
 #include <SCIUtil/Concurrent/LockGuard.h>
 
 #include <httplib/httplib.h>
@@ -136,6 +137,10 @@ namespace SCI::BAT::Webserver
              * @param user User to destroy session for
             */
             static void Destroy(HTTPUser& user);
+            /*!
+             * @brief Removes all expired sessions (executed periodically by the webserver)
+            */
+            static void Cleanup();
 
             /*!
              * @brief Retrive user permission based on its name
@@ -145,13 +150,13 @@ namespace SCI::BAT::Webserver
             static HTTPUser::PermissionLevel GetUserPermission(const HTTPUser& user);
 
             /*!
-             * @brief Converts a clear text password into an hash
+             * @brief Converts a clear text password into an hash (expensive, never call while holding a lock)
              * @param password Input password
              * @return Output hash
             */
             static std::string HashPassword(const std::string& password);
             /*!
-             * @brief Checks if a password matches the stored hash
+             * @brief Checks if a password matches the stored hash (expensive, never call while holding a lock)
              * @param storedHash Input stored hash
              * @param password Input clear text password
              * @return true if password matches the hash
@@ -174,12 +179,8 @@ namespace SCI::BAT::Webserver
 
             static HTTPAuthentication s_instance;
 
-            void DoCleanup();
-
         private:
-            Util::SpinLock m_lock;
+            Util::SharedAdaptiveLock m_lock{ "webserver.sessions" };
             std::map<std::string, SessionData> m_sessions;
-
-            std::chrono::system_clock::time_point m_lastCleanup = std::chrono::system_clock::now();
     };
 }
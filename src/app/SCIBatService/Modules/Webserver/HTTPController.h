@@ -11,6 +11,7 @@
 
 #include <SCIUtil/Exception.h>
 #include <SCIUtil/SPDLogable.h>
+#include <SCIUtil/Trace/Tracer.h>
 
 #include <httplib/httplib.h>
 #include <spdlog/spdlog.h>
@@ -259,16 +260,16 @@ namespace SCI::BAT::Webserver
             {
                 // Info
                 const std::type_info& tInfo = typeid(T);
-                logger->debug("Registering controller {} (\"{}\")", tInfo.name(), controller->ToString());
+                SCI_LOG_DEBUG(logger, "Registering controller {} (\"{}\")", tInfo.name(), controller->ToString());
 
                 // Functions
                 size_t registrations = 0;
-                if (HTTPControllerOverloadChecker<T>::Get()) { server.Get(route, std::bind(&HTTPController::OnGet, controller, std::placeholders::_1, std::placeholders::_2)); registrations++; }
-                if (HTTPControllerOverloadChecker<T>::Post()) { server.Post(route, httplib::Server::Handler(std::bind(&HTTPController::OnPost, controller, std::placeholders::_1, std::placeholders::_2))); registrations++; }
-                if (HTTPControllerOverloadChecker<T>::Put()) { server.Put(route, httplib::Server::Handler(std::bind(&HTTPController::OnPut, controller, std::placeholders::_1, std::placeholders::_2))); registrations++; }
-                if (HTTPControllerOverloadChecker<T>::Patch()) { server.Patch(route, httplib::Server::Handler(std::bind(&HTTPController::OnPatch, controller, std::placeholders::_1, std::placeholders::_2))); registrations++; }
-                if (HTTPControllerOverloadChecker<T>::Delete()) { server.Delete(route, httplib::Server::Handler(std::bind(&HTTPController::OnDelete, controller, std::placeholders::_1, std::placeholders::_2))); registrations++; }
-                if (HTTPControllerOverloadChecker<T>::Options()) { server.Options(route, std::bind(&HTTPController::OnOptions, controller, std::placeholders::_1, std::placeholders::_2)); registrations++; }
+                if (HTTPControllerOverloadChecker<T>::Get()) { server.Get(route, TracedHandler(controller, &HTTPController::OnGet, route)); registrations++; }
+                if (HTTPControllerOverloadChecker<T>::Post()) { server.Post(route, TracedHandler(controller, &HTTPController::OnPost, route)); registrations++; }
+                if (HTTPControllerOverloadChecker<T>::Put()) { server.Put(route, TracedHandler(controller, &HTTPController::OnPut, route)); registrations++; }
+                if (HTTPControllerOverloadChecker<T>::Patch()) { server.Patch(route, TracedHandler(controller, &HTTPController::OnPatch, route)); registrations++; }
+                if (HTTPControllerOverloadChecker<T>::Delete()) { server.Delete(route, TracedHandler(controller, &HTTPController::OnDelete, route)); registrations++; }
+                if (HTTPControllerOverloadChecker<T>::Options()) { server.Options(route, TracedHandler(controller, &HTTPController::OnOptions, route)); registrations++; }
 
                 // Check
                 if (registrations == 0)
@@ -280,6 +281,22 @@ namespace SCI::BAT::Webserver
                 registerController(controller);
                 return *controller;
             }
+
+            /*!
+             * @brief Creates a request handler that records every request as trace span (named by the route)
+             * @param controller Controller handling the request
+             * @param handler Handler function of the controller
+             * @param route Route of the controller
+             * @return Handler for the server
+            */
+            static httplib::Server::Handler TracedHandler(HTTPController* controller, void(HTTPController::* handler)(const httplib::Request&, httplib::Response&), const std::string& route)
+            {
+                return [controller, handler, route](const httplib::Request& request, httplib::Response& response)
+                    {
+                        SCI_TRACE_SCOPE("http", route);
+                        (controller->*handler)(request, response);
+                    };
+            }
     };
 
     /*!
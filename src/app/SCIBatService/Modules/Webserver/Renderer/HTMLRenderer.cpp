@@ -14,7 +14,7 @@ std::string SCI::BAT::Webserver::HTMLRenderer::RenderTemplate(const std::filesys
     SCI_ASSERT_FMT(std::filesystem::exists(viewPath), "Can't open file \"{}\"", viewPath.generic_string());
 
     // Create template
-    GetLogger()->debug("Using view \"{}\" from file", view.generic_string());
+    SCI_LOG_DEBUG(GetLogger(), "Using view \"{}\" from file", view.generic_string());
     auto tpl = env.parse_template(viewPath.generic_string());
 
     // Render
@@ -8,6 +8,7 @@ SCI::BAT::Webserver::WebserverThread::WebserverThread(const std::filesystem::pat
     m_renderer(serverRootDir / "templates"),
     m_webappLogger(webappLogger)
 {
+    SetName("webserver");
     SetLogger(logger);
     m_renderer.SetLogger(GetLogger());
     HTTPAuthentication::Instance().SetLogger(logger);
@@ -55,12 +56,12 @@ void SCI::BAT::Webserver::WebserverThread::RegisterRoutes()
 
 void SCI::BAT::Webserver::WebserverThread::OnRequestLog(const httplib::Request& request, const httplib::Response& response)
 {
-    GetLogger()->debug("{} request from {} to \"{}\". In-Bytes: {} Out-Bytes: {} ", request.method, request.remote_addr, request.path, request.body.size(), response.body.size());
+    SCI_LOG_DEBUG(GetLogger(), "{} request from {} to \"{}\". In-Bytes: {} Out-Bytes: {} ", request.method, request.remote_addr, request.path, request.body.size(), response.body.size());
 }
 
 void SCI::BAT::Webserver::WebserverThread::OnRequestError(const httplib::Request& request, httplib::Response& response)
 {
-    GetLogger()->trace("Beginning HTTP error handler for for \"{}\" from {}", request.path, request.remote_addr);
+    SCI_LOG_TRACE(GetLogger(), "Beginning HTTP error handler for for \"{}\" from {}", request.path, request.remote_addr);
     bool handledSuccessfully = true;
     try
     {
@@ -87,19 +88,19 @@ void SCI::BAT::Webserver::WebserverThread::OnRequestError(const httplib::Request
         RenderFinalError(response.status, "Error occurred while reporting exception thrown during web request.", request, response);
     }
 
-    GetLogger()->trace("HTTP error handler finished");
+    SCI_LOG_TRACE(GetLogger(), "HTTP error handler finished");
 }
 
 void SCI::BAT::Webserver::WebserverThread::OnRequestException(const httplib::Request& request, httplib::Response& response, std::exception_ptr pex)
 {
-    GetLogger()->trace("Beginning HTTP exception handler for \"{}\" from {}", request.path, request.remote_addr);
+    SCI_LOG_TRACE(GetLogger(), "Beginning HTTP exception handler for \"{}\" from {}", request.path, request.remote_addr);
     // Re throw
     bool handledSuccessfully = true;
     try
     {
         if (pex)
         {
-            GetLogger()->trace("Rethrowing exception");
+            SCI_LOG_TRACE(GetLogger(), "Rethrowing exception");
             std::rethrow_exception(pex);
         }
     }
@@ -108,7 +109,7 @@ void SCI::BAT::Webserver::WebserverThread::OnRequestException(const httplib::Req
         // We don't want to generate any further throw beyond this border! It will crash the server if an exception travels above this function!
         try
         {
-            GetLogger()->trace("Exception picked up");
+            SCI_LOG_TRACE(GetLogger(), "Exception picked up");
             GetLogger()->error("Exception occured during handling of a HTTP request: {} [Request: {} {}]", rex.what(), request.method, request.path);
 
             // Render exception
@@ -129,12 +130,12 @@ void SCI::BAT::Webserver::WebserverThread::OnRequestException(const httplib::Req
     // Handle most fatal error
     if (!handledSuccessfully)
     {
-        GetLogger()->trace("Exception handler faulty. Providing bare minimum response.");
+        SCI_LOG_TRACE(GetLogger(), "Exception handler faulty. Providing bare minimum response.");
         response.status = 500;
         RenderFinalError(response.status, "Error occurred while reporting exception thrown during web request.", request, response);
     }
 
-    GetLogger()->trace("HTTP exception handler finished");
+    SCI_LOG_TRACE(GetLogger(), "HTTP exception handler finished");
 }
 
 int SCI::BAT::Webserver::WebserverThread::ThreadMain()
@@ -146,9 +147,16 @@ int SCI::BAT::Webserver::WebserverThread::ThreadMain()
         controller->OnListen(m_serverHost, m_serverPort);
     }
 
+    // Expired sessions are removed in the background
+    using namespace std::chrono_literals;
+    m_sessionCleanupTask = Executor::Get().Periodic(15min, &HTTPAuthentication::Cleanup, Executor::Priority::Low);
+
     // Run server
     GetLogger()->info("Target start reached");
-    return m_server.listen_after_bind() ? 0 : -1;
+    bool listenOk = m_server.listen_after_bind();
+
+    Executor::Get().Cancel(m_sessionCleanupTask);
+    return listenOk ? 0 : -1;
 }
 
 void SCI::BAT::Webserver::WebserverThread::OnStop()
@@ -190,7 +198,7 @@ void SCI::BAT::Webserver::WebserverThread::RenderTemplatedError(int code, const
 
 void SCI::BAT::Webserver::WebserverThread::RenderFinalError(int code, const std::string_view& description, const httplib::Request& request, httplib::Response& response)
 {
-    GetLogger()->trace("Error handler faulty. Providing bare minimum response.");
+    SCI_LOG_TRACE(GetLogger(), "Error handler faulty. Providing bare minimum response.");
     inja::json data;
     data["code"] = response.status;
     #ifdef _DEBUG
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Threading/Thread.h>
+#include <Threading/Executor.h>
 #include <Modules/Webserver/HTTPController.h>
 #include <Modules/Webserver/HTTPAuthentication.h>
 #include <Modules/Webserver/Renderer/HTMLRenderer.h>
@@ -136,6 +137,7 @@ namespace SCI::BAT::Webserver
             std::shared_ptr<spdlog::logger> m_webappLogger;
 
             HTMLRenderer m_renderer;
+            Executor::TaskId m_sessionCleanupTask = 0;
             const char* m_finalErrorMessage = R"(<!DOCTYPE html><html><body style="padding: 0; margin: 0; background: LightGray;"><div style="min-height: 4em; padding: 1em; background: rgb(220, 10, 10); "><h2>Error Occured (Code {{code}})</h2></div> <div style="padding: 1em;"><p>A fatal error occured! Please contacte the server admin if you think this is an issue!<br/>Message: {{description}}<br/><br/><b>{{footer}}</b></p></div></body></html>)";
             std::string m_finalErrorFooter = "";
     };
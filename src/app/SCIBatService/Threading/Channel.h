@@ -0,0 +1,147 @@
+ /*!
+  * @file Channel.h
+  * @brief Thread safe queue that can be awaited by a coroutine.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <Threading/EventLoop.h>
+
+#include <SCIUtil/Concurrent/SpinLock.h>
+#include <SCIUtil/Concurrent/LockGuard.h>
+
+#include <coroutine>
+#include <deque>
+#include <optional>
+#include <utility>
+
+namespace SCI::BAT
+{
+    /*!
+     * @brief Multi producer, single consumer queue.
+     *
+     * Any thread may send values. A single coroutine receives them and is resumed on its EventLoop when a value arrives.
+     * @tparam T Type of the values
+    */
+    template<typename T>
+    class Channel
+    {
+        public:
+            /*!
+             * @brief Awaitable returning the next value (or nothing once the channel was closed and drained)
+            */
+            class ReceiveAwaitable
+            {
+                public:
+                    ReceiveAwaitable(Channel& channel, EventLoop& loop) :
+                        m_channel(channel), m_loop(loop)
+                    {}
+
+                    inline bool await_ready() const noexcept
+                    {
+                        return false;
+                    }
+                    inline bool await_suspend(std::coroutine_handle<> handle)
+                    {
+                        Util::LockGuard janitor(m_channel.m_lock);
+                        if (!m_channel.m_queue.empty() || m_channel.m_closed)
+                        {
+                            return false;
+                        }
+
+                        SCI_ASSERT(!m_channel.m_waiter, "Channel supports only a single receiver");
+                        m_channel.m_waiter = handle;
+                        m_channel.m_waiterLoop = &m_loop;
+                        return true;
+                    }
+                    inline std::optional<T> await_resume()
+                    {
+                        return m_channel.TryReceive();
+                    }
+
+                private:
+                    Channel& m_channel;
+                    EventLoop& m_loop;
+            };
+
+        public:
+            Channel() = default;
+            Channel(const Channel&) = delete;
+            Channel(Channel&&) noexcept = delete;
+
+            Channel& operator=(const Channel&) = delete;
+            Channel& operator=(Channel&&) noexcept = delete;
+
+            /*!
+             * @brief Queues a value and resumes the receiver (thread safe)
+             * @param value Value to be sent
+             * @return False if the channel is closed
+            */
+            bool Send(T value)
+            {
+                Util::LockGuard janitor(m_lock);
+                if (m_closed)
+                {
+                    return false;
+                }
+                m_queue.push_back(std::move(value));
+                auto waiter = std::exchange(m_waiter, nullptr);
+                auto* loop = m_waiterLoop;
+                janitor.Release();
+
+                if (waiter)
+                {
+                    loop->Post(waiter);
+                }
+                return true;
+            }
+            /*!
+             * @brief Closes the channel. A waiting receiver is resumed (thread safe)
+            */
+            void Close()
+            {
+                Util::LockGuard janitor(m_lock);
+                m_closed = true;
+                auto waiter = std::exchange(m_waiter, nullptr);
+                auto* loop = m_waiterLoop;
+                janitor.Release();
+
+                if (waiter)
+                {
+                    loop->Post(waiter);
+                }
+            }
+
+            /*!
+             * @brief Takes the next value without waiting
+             * @return Value or nothing if the channel is empty
+            */
+            std::optional<T> TryReceive()
+            {
+                Util::LockGuard janitor(m_lock);
+                if (m_queue.empty())
+                {
+                    return std::nullopt;
+                }
+                std::optional<T> value = std::move(m_queue.front());
+                m_queue.pop_front();
+                return value;
+            }
+            /*!
+             * @brief Waits for the next value
+             * @param loop Event loop executing the receiving coroutine
+             * @return Awaitable (evaluates to the value or nothing once the channel is closed)
+            */
+            inline ReceiveAwaitable Receive(EventLoop& loop)
+            {
+                return ReceiveAwaitable(*this, loop);
+            }
+
+        private:
+            Util::SpinLock m_lock;
+            std::deque<T> m_queue;
+            std::coroutine_handle<> m_waiter;
+            EventLoop* m_waiterLoop = nullptr;
+            bool m_closed = false;
+    };
+}
@@ -0,0 +1,13 @@
+#include "CoThread.h"
+
+void SCI::BAT::CoThread::OnWake()
+{
+    m_loop.Interrupt();
+}
+
+int SCI::BAT::CoThread::ThreadMain()
+{
+    // A stop request ends the current sleep. The coroutine observes it via StopRequested()
+    std::stop_callback onStop(GetStopToken(), [this]() { m_loop.Interrupt(); });
+    return m_loop.Run(CoMain());
+}
@@ -0,0 +1,68 @@
+ /*!
+  * @file CoThread.h
+  * @brief Thread whose main function is a coroutine.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <Threading/Thread.h>
+#include <Threading/Task.h>
+#include <Threading/EventLoop.h>
+
+#include <chrono>
+
+namespace SCI::BAT
+{
+    /*!
+     * @brief Thread that executes a coroutine on its own EventLoop.
+     *
+     * Modules written as coroutines can run additional tasks on the same thread (Spawn()) instead of owning further threads.
+     * Wake(), config reload requests and stop requests interrupt the current Sleep() like on a normal Thread.
+    */
+    class CoThread : public Thread
+    {
+        protected:
+            /*!
+             * @brief Main coroutine of the thread
+             * @return Return code of the thread
+            */
+            virtual Task<int> CoMain() = 0;
+
+            /*!
+             * @brief Suspends the calling coroutine (the thread keeps serving other tasks)
+             * @tparam Rep Duration representation.
+             * @tparam Period Duration period.
+             * @param duration Maximum time to sleep
+             * @return Awaitable (evaluates to true if the thread was woken before the duration elapsed)
+            */
+            template<typename Rep, typename Period>
+            inline EventLoop::SleepAwaitable Sleep(const std::chrono::duration<Rep, Period>& duration)
+            {
+                return m_loop.Sleep(duration);
+            }
+            /*!
+             * @brief Starts a task concurrently to the main coroutine
+             * @param task Task to be started
+            */
+            inline void Spawn(Task<void> task)
+            {
+                m_loop.Spawn(std::move(task));
+            }
+            /*!
+             * @brief Accesses the event loop of the thread
+             * @return Reference to event loop
+            */
+            inline EventLoop& GetEventLoop()
+            {
+                return m_loop;
+            }
+
+            void OnWake() override;
+
+        private:
+            int ThreadMain() final;
+
+        private:
+            EventLoop m_loop;
+    };
+}
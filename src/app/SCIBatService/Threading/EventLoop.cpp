@@ -0,0 +1,188 @@
+#include "EventLoop.h"
+
+#if defined(SCI_WINDOWS)
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(SCI_LINUX)
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+
+SCI::BAT::EventLoop::EventLoop()
+{
+    #if defined(SCI_LINUX)
+    m_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    SCI_ASSERT_FMT(m_eventFd >= 0, "Failed to create eventfd (errno {})", errno);
+    #endif
+}
+
+SCI::BAT::EventLoop::~EventLoop()
+{
+    #if defined(SCI_LINUX)
+    if (m_eventFd >= 0)
+    {
+        close(m_eventFd);
+    }
+    #endif
+}
+
+int SCI::BAT::EventLoop::Run(Task<int> main)
+{
+    m_ready.push_back(main.GetHandle());
+
+    try
+    {
+        while (!main.Done())
+        {
+            CollectWaiters();
+            ResumeReady();
+
+            // Finished tasks are released (a failed task terminates the loop)
+            for (auto it = m_tasks.begin(); it != m_tasks.end();)
+            {
+                if (it->Done())
+                {
+                    it->Result();
+                    it = m_tasks.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            if (main.Done())
+                break;
+
+            // Sleep until the next deadline or an external event
+            auto until = std::chrono::steady_clock::time_point::max();
+            if (!m_timers.empty())
+            {
+                until = m_timers.begin()->first;
+            }
+            WaitForEvents(until);
+        }
+    }
+    catch (...)
+    {
+        // Suspended coroutines are destroyed below. Nothing may reference their awaiters anymore
+        m_timers.clear();
+        m_ready.clear();
+        m_tasks.clear();
+        throw;
+    }
+
+    m_timers.clear();
+    m_ready.clear();
+    m_tasks.clear();
+
+    std::lock_guard lock(m_postMutex);
+    m_posted.clear();
+    return main.Result();
+}
+
+void SCI::BAT::EventLoop::Spawn(Task<void> task)
+{
+    m_ready.push_back(task.GetHandle());
+    m_tasks.push_back(std::move(task));
+}
+
+void SCI::BAT::EventLoop::Post(std::coroutine_handle<> handle)
+{
+    {
+        std::lock_guard lock(m_postMutex);
+        m_posted.push_back(handle);
+    }
+    Signal();
+}
+
+void SCI::BAT::EventLoop::Interrupt()
+{
+    m_interruptRequested = true;
+    Signal();
+}
+
+void SCI::BAT::EventLoop::ResumeReady()
+{
+    while (!m_ready.empty())
+    {
+        auto handle = m_ready.front();
+        m_ready.pop_front();
+        handle.resume();
+    }
+}
+
+void SCI::BAT::EventLoop::CollectWaiters()
+{
+    // Cross thread posts
+    {
+        std::lock_guard lock(m_postMutex);
+        m_ready.insert(m_ready.end(), m_posted.begin(), m_posted.end());
+        m_posted.clear();
+    }
+
+    // Interrupt ends all current waits
+    if (m_interruptRequested.exchange(false))
+    {
+        for (auto& [due, waiter] : m_timers)
+        {
+            waiter->interrupted = true;
+            m_ready.push_back(waiter->handle);
+        }
+        m_timers.clear();
+    }
+
+    // Expired timers
+    auto now = std::chrono::steady_clock::now();
+    while (!m_timers.empty() && m_timers.begin()->first <= now)
+    {
+        m_ready.push_back(m_timers.begin()->second->handle);
+        m_timers.erase(m_timers.begin());
+    }
+}
+
+void SCI::BAT::EventLoop::WaitForEvents(std::chrono::steady_clock::time_point until)
+{
+    #if defined(SCI_LINUX)
+    int timeout = -1;
+    if (until != std::chrono::steady_clock::time_point::max())
+    {
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(until - std::chrono::steady_clock::now());
+        timeout = (int)std::max<int64_t>(remaining.count(), 0);
+    }
+
+    pollfd fd = { m_eventFd, POLLIN, 0 };
+    if (poll(&fd, 1, timeout) > 0 && (fd.revents & POLLIN))
+    {
+        uint64_t value;
+        [[maybe_unused]] auto bytesRead = read(m_eventFd, &value, sizeof(value));
+    }
+    #else
+    std::unique_lock lock(m_postMutex);
+    if (until == std::chrono::steady_clock::time_point::max())
+    {
+        m_postCondition.wait(lock, [this]() { return m_signaled; });
+    }
+    else
+    {
+        m_postCondition.wait_until(lock, until, [this]() { return m_signaled; });
+    }
+    m_signaled = false;
+    #endif
+}
+
+void SCI::BAT::EventLoop::Signal()
+{
+    #if defined(SCI_LINUX)
+    uint64_t value = 1;
+    [[maybe_unused]] auto bytesWritten = write(m_eventFd, &value, sizeof(value));
+    #else
+    {
+        std::lock_guard lock(m_postMutex);
+        m_signaled = true;
+    }
+    // Only the loop thread waits on the condition
+    m_postCondition.notify_one();
+    #endif
+}
@@ -0,0 +1,146 @@
+ /*!
+  * @file EventLoop.h
+  * @brief Single threaded scheduler for coroutines (timers and cross thread posts).
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <Threading/Task.h>
+
+#include <SCIUtil/Exception.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace SCI::BAT
+{
+    /*!
+     * @brief Runs any number of coroutines on the calling thread.
+     *
+     * The thread only wakes up when a timer expires or another thread posts work.
+     * Apart from Post() and Interrupt() all functions must be called from the thread executing Run().
+    */
+    class EventLoop
+    {
+        private:
+            /*!
+             * @brief Coroutine suspended inside the loop
+            */
+            struct Waiter
+            {
+                /*! Coroutine to be resumed */
+                std::coroutine_handle<> handle;
+                /*! Resumed early by Interrupt() */
+                bool interrupted = false;
+            };
+
+        public:
+            /*!
+             * @brief Awaitable suspending the coroutine until a point in time
+            */
+            class SleepAwaitable : private Waiter
+            {
+                public:
+                    SleepAwaitable(EventLoop& loop, std::chrono::steady_clock::time_point due) :
+                        m_loop(loop), m_due(due)
+                    {}
+
+                    inline bool await_ready() const noexcept
+                    {
+                        return m_due <= std::chrono::steady_clock::now();
+                    }
+                    inline void await_suspend(std::coroutine_handle<> handle)
+                    {
+                        this->handle = handle;
+                        m_loop.m_timers.emplace(m_due, this);
+                    }
+                    /*!
+                     * @return True if the sleep was ended early by Interrupt()
+                    */
+                    inline bool await_resume() const noexcept
+                    {
+                        return interrupted;
+                    }
+
+                private:
+                    EventLoop& m_loop;
+                    std::chrono::steady_clock::time_point m_due;
+
+                    friend class EventLoop;
+            };
+
+        public:
+            EventLoop();
+            EventLoop(const EventLoop&) = delete;
+            EventLoop(EventLoop&&) noexcept = delete;
+            ~EventLoop();
+
+            EventLoop& operator=(const EventLoop&) = delete;
+            EventLoop& operator=(EventLoop&&) noexcept = delete;
+
+            /*!
+             * @brief Executes the loop until the main task finished. Tasks spawned on the loop that are still suspended afterwards are destroyed.
+             *
+             * Exceptions of the main task and of spawned tasks are thrown by this function.
+             * @param main Main task
+             * @return Result of the main task
+            */
+            int Run(Task<int> main);
+            /*!
+             * @brief Starts a task on this loop that runs concurrently to the awaiting coroutines
+             * @param task Task to be started
+            */
+            void Spawn(Task<void> task);
+
+            /*!
+             * @brief Schedules a suspended coroutine for resumption on the loop (thread safe).
+             * @param handle Coroutine to be resumed
+            */
+            void Post(std::coroutine_handle<> handle);
+            /*!
+             * @brief Ends all current sleeps early (thread safe).
+            */
+            void Interrupt();
+
+            /*!
+             * @brief Suspends the calling coroutine
+             * @tparam Rep Duration representation.
+             * @tparam Period Duration period.
+             * @param duration Time to sleep
+             * @return Awaitable (evaluates to true if the sleep was interrupted)
+            */
+            template<typename Rep, typename Period>
+            inline SleepAwaitable Sleep(const std::chrono::duration<Rep, Period>& duration)
+            {
+                return SleepAwaitable(*this, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+            }
+
+        private:
+            void ResumeReady();
+            void CollectWaiters();
+            void WaitForEvents(std::chrono::steady_clock::time_point until);
+            void Signal();
+
+        private:
+            std::deque<std::coroutine_handle<>> m_ready;
+            std::vector<Task<void>> m_tasks;
+            std::multimap<std::chrono::steady_clock::time_point, SleepAwaitable*> m_timers;
+
+            // Cross thread
+            std::mutex m_postMutex;
+            std::vector<std::coroutine_handle<>> m_posted;
+            std::atomic_bool m_interruptRequested = false;
+            #if defined(SCI_LINUX)
+            int m_eventFd = -1;
+            #else
+            std::condition_variable m_postCondition;
+            bool m_signaled = false;
+            #endif
+    };
+}
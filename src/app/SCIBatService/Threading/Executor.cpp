@@ -0,0 +1,301 @@
+#include "Executor.h"
+
+SCI::BAT::Executor* SCI::BAT::Executor::s_executor = nullptr;
+thread_local SCI::BAT::Executor::Worker* SCI::BAT::Executor::s_currentWorker = nullptr;
+
+SCI::BAT::Executor::Executor(size_t workerCount, const std::shared_ptr<spdlog::logger>& logger)
+{
+    SetName("executor");
+    SetLogger(logger);
+    s_executor = this;
+
+    if (workerCount == 0)
+    {
+        workerCount = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+    }
+
+    // Queues exist before the workers are started (tasks can be posted during initialization)
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        auto& worker = m_workers.emplace_back(std::make_unique<Worker>());
+        worker->executor = this;
+        worker->index = i;
+        if (i > 0)
+        {
+            worker->profile = std::make_unique<ThreadProfile>();
+            worker->profile->SetName(fmt::format("executor.{}", i));
+        }
+    }
+}
+
+SCI::BAT::Executor::~Executor()
+{
+    // Workers reference members of this class
+    Stop();
+    Wait();
+
+    if (s_executor == this)
+    {
+        s_executor = nullptr;
+    }
+}
+
+void SCI::BAT::Executor::Post(Task task, Priority priority /*= Priority::Normal*/)
+{
+    // Tasks posted by a worker stay on that worker (cache locality), everything else is distributed round robin
+    Worker* worker = s_currentWorker && s_currentWorker->executor == this ?
+        s_currentWorker : m_workers[m_nextWorker.fetch_add(1, std::memory_order::relaxed) % m_workers.size()].get();
+
+    Util::LockGuard janitor(worker->lock);
+    worker->queues[(size_t)priority].push_back(std::move(task));
+    janitor.Release();
+
+    SignalWork();
+    if (worker == m_workers.front().get() && s_currentWorker != worker)
+    {
+        // The executor thread sleeps on its timers, not on the work signal
+        Wake();
+    }
+}
+
+SCI::BAT::Executor::TaskId SCI::BAT::Executor::Schedule(std::chrono::steady_clock::duration delay, Task task, Priority priority /*= Priority::Normal*/)
+{
+    return AddTimer(delay, std::chrono::steady_clock::duration::zero(), std::move(task), priority);
+}
+
+SCI::BAT::Executor::TaskId SCI::BAT::Executor::Periodic(std::chrono::steady_clock::duration interval, Task task, Priority priority /*= Priority::Normal*/)
+{
+    SCI_ASSERT(interval > std::chrono::steady_clock::duration::zero(), "Interval of a periodic task must be positive");
+    return AddTimer(interval, interval, std::move(task), priority);
+}
+
+bool SCI::BAT::Executor::Cancel(TaskId id)
+{
+    // The heap entry is dropped lazily when it becomes due
+    Util::LockGuard janitor(m_timerLock);
+    auto itTimer = m_timers.find(id);
+    if (itTimer != m_timers.end())
+    {
+        itTimer->second->cancelled = true;
+        m_timers.erase(itTimer);
+        return true;
+    }
+    return false;
+}
+
+SCI::BAT::Executor::Stats SCI::BAT::Executor::GetStats()
+{
+    Stats stats;
+    stats.workers = m_workers.size();
+    stats.executed = m_executed.load(std::memory_order::relaxed);
+    stats.stolen = m_stolen.load(std::memory_order::relaxed);
+    stats.failed = m_failed.load(std::memory_order::relaxed);
+
+    Util::LockGuard janitor(m_timerLock);
+    stats.timers = m_timers.size();
+    return stats;
+}
+
+int SCI::BAT::Executor::ThreadMain()
+{
+    using namespace std::chrono_literals;
+
+    GetLogger()->info("Starting {} executor workers", m_workers.size());
+    for (size_t i = 1; i < m_workers.size(); i++)
+    {
+        m_workers[i]->thread = std::jthread([this, &worker = *m_workers[i]]() { WorkerMain(worker); });
+    }
+
+    // Timer loop (this thread is the first worker)
+    auto& worker = *m_workers.front();
+    s_currentWorker = &worker;
+    std::vector<std::shared_ptr<Timer>> dueTimers;
+    Task task;
+    while (!StopRequested())
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto next = now + 1s;
+
+        Util::LockGuard janitor(m_timerLock);
+        while (!m_timerHeap.empty() && m_timerHeap.front().due <= now)
+        {
+            std::pop_heap(m_timerHeap.begin(), m_timerHeap.end(), std::greater<TimerEntry>());
+            dueTimers.push_back(std::move(m_timerHeap.back().timer));
+            m_timerHeap.pop_back();
+        }
+        if (!m_timerHeap.empty())
+        {
+            next = std::min(next, m_timerHeap.front().due);
+        }
+        janitor.Release();
+
+        for (auto& timer : dueTimers)
+        {
+            if (!timer->cancelled)
+            {
+                auto priority = timer->priority;
+                Post([this, timer = std::move(timer)]() { FireTimer(timer); }, priority);
+            }
+        }
+        dueTimers.clear();
+
+        // Execute tasks until the next timer is due
+        while (std::chrono::steady_clock::now() < next && TryTake(worker, task))
+        {
+            Run(task, &GetProfile());
+            task = nullptr;
+        }
+
+        // Arming a new timer or posting to this worker wakes the loop
+        Sleep(next - std::chrono::steady_clock::now());
+    }
+    s_currentWorker = nullptr;
+
+    // Stop the workers (pending tasks are dropped)
+    GetLogger()->info("Stopping executor workers");
+    m_stopping = true;
+    SignalWork(true);
+    for (auto& other : m_workers)
+    {
+        if (other->thread.joinable())
+        {
+            other->thread.join();
+        }
+    }
+
+    return 0;
+}
+
+void SCI::BAT::Executor::WorkerMain(Worker& worker)
+{
+    s_currentWorker = &worker;
+    worker.profile->Attach();
+
+    Task task;
+    while (!m_stopping.load(std::memory_order::acquire))
+    {
+        // Read the signal before searching. A task posted after the search changes the value and prevents the wait
+        uint32_t signal = m_workSignal.load(std::memory_order::acquire);
+        if (TryTake(worker, task))
+        {
+            Run(task, worker.profile.get());
+            task = nullptr;
+        }
+        else
+        {
+            m_workSignal.wait(signal, std::memory_order::acquire);
+        }
+    }
+
+    worker.profile->Detach();
+    s_currentWorker = nullptr;
+}
+
+bool SCI::BAT::Executor::TryTake(Worker& worker, Task& task)
+{
+    for (size_t priority = 0; priority < worker.queues.size(); priority++)
+    {
+        // Own queue (oldest first)
+        Util::LockGuard janitor(worker.lock);
+        auto& queue = worker.queues[priority];
+        if (!queue.empty())
+        {
+            task = std::move(queue.front());
+            queue.pop_front();
+            return true;
+        }
+        janitor.Release();
+
+        // Steal from the other workers (newest first, keeps the victims order intact)
+        for (size_t offset = 1; offset < m_workers.size(); offset++)
+        {
+            auto& victim = *m_workers[(worker.index + offset) % m_workers.size()];
+            Util::LockGuard victimJanitor(victim.lock);
+            auto& victimQueue = victim.queues[priority];
+            if (!victimQueue.empty())
+            {
+                task = std::move(victimQueue.back());
+                victimQueue.pop_back();
+                m_stolen.fetch_add(1, std::memory_order::relaxed);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void SCI::BAT::Executor::Run(Task& task, ThreadProfile* profile /*= nullptr*/)
+{
+    std::optional<ThreadProfile::Iteration> iteration;
+    if (profile)
+    {
+        iteration.emplace(*profile);
+    }
+    SCI_TRACE_SCOPE("executor", "Executor::Task");
+
+    try
+    {
+        task();
+    }
+    catch (std::exception& ex)
+    {
+        GetLogger()->error("Exception in executor task: {}", ex.what());
+        m_failed.fetch_add(1, std::memory_order::relaxed);
+    }
+    catch (...)
+    {
+        GetLogger()->error("Unknown exception in executor task.");
+        m_failed.fetch_add(1, std::memory_order::relaxed);
+    }
+    m_executed.fetch_add(1, std::memory_order::relaxed);
+}
+
+SCI::BAT::Executor::TaskId SCI::BAT::Executor::AddTimer(std::chrono::steady_clock::duration delay, std::chrono::steady_clock::duration interval, Task task, Priority priority)
+{
+    auto timer = std::make_shared<Timer>();
+    timer->task = std::move(task);
+    timer->interval = interval;
+    timer->priority = priority;
+
+    Util::LockGuard janitor(m_timerLock);
+    timer->id = m_nextTimerId++;
+    m_timers[timer->id] = timer;
+    janitor.Release();
+
+    ArmTimer(std::chrono::steady_clock::now() + delay, timer);
+    return timer->id;
+}
+
+void SCI::BAT::Executor::ArmTimer(std::chrono::steady_clock::time_point due, const std::shared_ptr<Timer>& timer)
+{
+    Util::LockGuard janitor(m_timerLock);
+    m_timerHeap.push_back({ due, timer });
+    std::push_heap(m_timerHeap.begin(), m_timerHeap.end(), std::greater<TimerEntry>());
+    janitor.Release();
+
+    Wake();
+}
+
+void SCI::BAT::Executor::FireTimer(const std::shared_ptr<Timer>& timer)
+{
+    if (timer->cancelled)
+        return;
+
+    Run(timer->task);
+
+    if (timer->interval > std::chrono::steady_clock::duration::zero())
+    {
+        // Periodic: Schedule relative to the end of this execution (no catch up bursts)
+        if (!timer->cancelled)
+        {
+            ArmTimer(std::chrono::steady_clock::now() + timer->interval, timer);
+        }
+    }
+    else
+    {
+        Util::LockGuard janitor(m_timerLock);
+        m_timers.erase(timer->id);
+    }
+}
@@ -0,0 +1,234 @@
+ /*!
+  * @file Executor.h
+  * @brief Shared work stealing task scheduler with timers.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <Threading/Thread.h>
+
+#include <SCIUtil/SPDLogable.h>
+#include <SCIUtil/Exception.h>
+#include <SCIUtil/Concurrent/SpinLock.h>
+#include <SCIUtil/Concurrent/LockGuard.h>
+#include <SCIUtil/Trace/Tracer.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace SCI::BAT
+{
+    /*!
+     * @brief Pool of worker threads executing short tasks for all modules.
+     *
+     * Every worker owns a task queue per priority. Tasks posted from a worker are queued on that worker, all other tasks are distributed round robin.
+     * Idle workers steal from the other queues before parking. The executor thread is the first worker: it drives the timers (delayed and
+     * periodic tasks) and executes tasks until the next timer is due, so a single worker needs no additional thread.
+     * Tasks must not block for long periods of time (device I/O belongs to a dedicated thread).
+    */
+    class Executor : public Thread, public Util::SPDLogable
+    {
+        public:
+            /*!
+             * @brief Task to be executed
+            */
+            using Task = std::function<void()>;
+            /*!
+             * @brief Identifies a scheduled (delayed or periodic) task. Zero is never a valid id.
+            */
+            using TaskId = uint64_t;
+
+            /*!
+             * @brief Priority of a task. Workers always drain higher priorities first.
+            */
+            enum class Priority
+            {
+                /*! Latency sensitive work (control messages) */
+                High = 0,
+                /*! Default priority */
+                Normal = 1,
+                /*! Housekeeping (cleanup, metrics) */
+                Low = 2,
+            };
+
+            /*!
+             * @brief Counters of the executor
+            */
+            struct Stats
+            {
+                /*! Number of workers (including the executor thread) */
+                size_t workers = 0;
+                /*! Tasks executed */
+                uint64_t executed = 0;
+                /*! Tasks taken from the queue of another worker */
+                uint64_t stolen = 0;
+                /*! Tasks that exited with an exception */
+                uint64_t failed = 0;
+                /*! Active delayed and periodic tasks */
+                size_t timers = 0;
+            };
+
+        public:
+            /*!
+             * @brief Creates the executor. Tasks may be posted before the executor is started.
+             * @param workerCount Number of workers including the executor thread (zero selects the number of hardware threads)
+             * @param logger Logger to be used
+            */
+            Executor(size_t workerCount = 0, const std::shared_ptr<spdlog::logger>& logger = spdlog::default_logger());
+            Executor(const Executor&) = delete;
+            Executor(Executor&&) noexcept = delete;
+            ~Executor();
+
+            Executor& operator=(const Executor&) = delete;
+            Executor& operator=(Executor&&) noexcept = delete;
+
+            /*!
+             * @brief Queues a task for immediate execution
+             * @param task Task to be executed
+             * @param priority Priority of the task
+            */
+            void Post(Task task, Priority priority = Priority::Normal);
+            /*!
+             * @brief Executes a task once after a delay
+             * @param delay Time until the task is due
+             * @param task Task to be executed
+             * @param priority Priority of the task
+             * @return Id for Cancel()
+            */
+            TaskId Schedule(std::chrono::steady_clock::duration delay, Task task, Priority priority = Priority::Normal);
+            /*!
+             * @brief Executes a task periodically.
+             *
+             * The next execution is scheduled after the previous one finished. A periodic task never runs in parallel with itself.
+             * @param interval Time between two executions (the first one is due after one interval)
+             * @param task Task to be executed
+             * @param priority Priority of the task
+             * @return Id for Cancel()
+            */
+            TaskId Periodic(std::chrono::steady_clock::duration interval, Task task, Priority priority = Priority::Normal);
+            /*!
+             * @brief Cancels a delayed or periodic task. A currently running execution will finish.
+             * @param id Id of the task
+             * @return True if the task was active
+            */
+            bool Cancel(TaskId id);
+
+            /*!
+             * @brief Reads the counters of the executor
+             * @return Current counters
+            */
+            Stats GetStats();
+
+            /*!
+             * @brief Retrieves the executor of the service
+             * @return Reference to the executor
+            */
+            static inline Executor& Get()
+            {
+                SCI_ASSERT(s_executor, "Executor not initialized");
+                return *s_executor;
+            }
+
+        protected:
+            int ThreadMain() override;
+
+        private:
+            /*!
+             * @brief Task queues of a single worker
+            */
+            struct Worker
+            {
+                /*! Executor owning the worker */
+                Executor* executor = nullptr;
+                /*! Index in the workers list */
+                size_t index = 0;
+                /*! Guards the queues */
+                Util::SpinLock lock;
+                /*! One queue per priority */
+                std::array<std::deque<Task>, 3> queues;
+                /*! Thread executing the worker (not used by the first worker, it runs on the executor thread) */
+                std::jthread thread;
+                /*! Profile of the worker thread (one iteration per task, the first worker uses the profile of the executor) */
+                std::unique_ptr<ThreadProfile> profile;
+            };
+
+            /*!
+             * @brief Delayed or periodic task
+            */
+            struct Timer
+            {
+                /*! Id of the task */
+                TaskId id = 0;
+                /*! Task to be executed */
+                Task task;
+                /*! Interval of periodic tasks (zero for one shot tasks) */
+                std::chrono::steady_clock::duration interval;
+                /*! Priority of the task */
+                Priority priority = Priority::Normal;
+                /*! Set by Cancel() */
+                std::atomic_bool cancelled = false;
+            };
+
+            /*!
+             * @brief Entry of the timer heap
+            */
+            struct TimerEntry
+            {
+                /*! Time the task is due */
+                std::chrono::steady_clock::time_point due;
+                /*! Task */
+                std::shared_ptr<Timer> timer;
+
+                inline bool operator>(const TimerEntry& other) const noexcept
+                {
+                    return due > other.due;
+                }
+            };
+
+        private:
+            void WorkerMain(Worker& worker);
+            bool TryTake(Worker& worker, Task& task);
+            void Run(Task& task, ThreadProfile* profile = nullptr);
+
+            TaskId AddTimer(std::chrono::steady_clock::duration delay, std::chrono::steady_clock::duration interval, Task task, Priority priority);
+            void ArmTimer(std::chrono::steady_clock::time_point due, const std::shared_ptr<Timer>& timer);
+            void FireTimer(const std::shared_ptr<Timer>& timer);
+
+            inline void SignalWork(bool all = false) noexcept
+            {
+                m_workSignal.fetch_add(1, std::memory_order::release);
+                if (all)
+                    m_workSignal.notify_all();
+                else
+                    m_workSignal.notify_one();
+            }
+
+        private:
+            static Executor* s_executor;
+            static thread_local Worker* s_currentWorker;
+
+            std::vector<std::unique_ptr<Worker>> m_workers;
+            std::atomic<size_t> m_nextWorker = 0;
+            std::atomic<uint32_t> m_workSignal = 0;
+            std::atomic_bool m_stopping = false;
+
+            Util::SpinLock m_timerLock;
+            std::vector<TimerEntry> m_timerHeap;
+            std::unordered_map<TaskId, std::shared_ptr<Timer>> m_timers;
+            TaskId m_nextTimerId = 1;
+
+            std::atomic<uint64_t> m_executed = 0;
+            std::atomic<uint64_t> m_stolen = 0;
+            std::atomic<uint64_t> m_failed = 0;
+    };
+}
@@ -0,0 +1,238 @@
+ /*!
+  * @file Task.h
+  * @brief Lazy C++20 coroutine type.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace SCI::BAT
+{
+    template<typename T>
+    class Task;
+
+    /*!
+     * @brief Promise part shared by all task types
+    */
+    class TaskPromiseBase
+    {
+        public:
+            /*!
+             * @brief Resumes the awaiting coroutine when the task finishes (symmetric transfer, no stack growth)
+            */
+            struct FinalAwaiter
+            {
+                inline bool await_ready() const noexcept
+                {
+                    return false;
+                }
+                template<typename P>
+                inline std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+                {
+                    auto continuation = handle.promise().m_continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+                inline void await_resume() const noexcept {}
+            };
+
+        public:
+            inline std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+            inline FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+            inline void unhandled_exception() noexcept
+            {
+                m_exception = std::current_exception();
+            }
+
+            /*!
+             * @brief Sets the coroutine to be resumed when the task finishes
+             * @param continuation Awaiting coroutine
+            */
+            inline void SetContinuation(std::coroutine_handle<> continuation) noexcept
+            {
+                m_continuation = continuation;
+            }
+
+        protected:
+            inline void RethrowException()
+            {
+                if (m_exception)
+                {
+                    std::rethrow_exception(m_exception);
+                }
+            }
+
+        private:
+            std::coroutine_handle<> m_continuation;
+            std::exception_ptr m_exception;
+    };
+
+    /*!
+     * @brief Promise of a task returning a value
+     * @tparam T Type of the value
+    */
+    template<typename T>
+    class TaskPromise : public TaskPromiseBase
+    {
+        public:
+            Task<T> get_return_object() noexcept;
+
+            inline void return_value(T value)
+            {
+                m_value = std::move(value);
+            }
+
+            /*!
+             * @brief Retrieves the result (rethrows the exception of the coroutine)
+             * @return Result
+            */
+            inline T Result()
+            {
+                RethrowException();
+                return std::move(*m_value);
+            }
+
+        private:
+            std::optional<T> m_value;
+    };
+
+    /*!
+     * @brief Promise of a task without value
+    */
+    template<>
+    class TaskPromise<void> : public TaskPromiseBase
+    {
+        public:
+            Task<void> get_return_object() noexcept;
+
+            inline void return_void() const noexcept {}
+
+            /*!
+             * @brief Rethrows the exception of the coroutine (if any)
+            */
+            inline void Result()
+            {
+                RethrowException();
+            }
+    };
+
+    /*!
+     * @brief Coroutine that starts executing when it is awaited (or handed to an EventLoop).
+     *
+     * Awaiting a task suspends the caller until the task finished and returns its result. Exceptions propagate to the awaiting coroutine.
+     * @tparam T Result type
+    */
+    template<typename T = void>
+    class Task
+    {
+        public:
+            using promise_type = TaskPromise<T>;
+            using Handle = std::coroutine_handle<promise_type>;
+
+            /*!
+             * @brief Awaiter that starts the task and resumes the caller when it finished
+            */
+            struct Awaiter
+            {
+                Handle handle;
+
+                inline bool await_ready() const noexcept
+                {
+                    return !handle || handle.done();
+                }
+                inline std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+                {
+                    handle.promise().SetContinuation(caller);
+                    return handle;
+                }
+                inline T await_resume()
+                {
+                    return handle.promise().Result();
+                }
+            };
+
+        public:
+            Task() = default;
+            explicit Task(Handle handle) noexcept :
+                m_handle(handle)
+            {}
+            Task(const Task&) = delete;
+            Task(Task&& other) noexcept :
+                m_handle(std::exchange(other.m_handle, nullptr))
+            {}
+            ~Task()
+            {
+                if (m_handle)
+                {
+                    m_handle.destroy();
+                }
+            }
+
+            Task& operator=(const Task&) = delete;
+            Task& operator=(Task&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    if (m_handle)
+                    {
+                        m_handle.destroy();
+                    }
+                    m_handle = std::exchange(other.m_handle, nullptr);
+                }
+                return *this;
+            }
+
+            inline Awaiter operator co_await() const noexcept
+            {
+                return { m_handle };
+            }
+
+            /*!
+             * @brief Checks if the coroutine ran to completion
+             * @return True when finished
+            */
+            inline bool Done() const noexcept
+            {
+                return !m_handle || m_handle.done();
+            }
+            /*!
+             * @brief Retrieves the result of a finished task (rethrows its exception)
+             * @return Result
+            */
+            inline T Result()
+            {
+                return m_handle.promise().Result();
+            }
+            /*!
+             * @brief Accesses the coroutine handle (for schedulers)
+             * @return Handle
+            */
+            inline Handle GetHandle() const noexcept
+            {
+                return m_handle;
+            }
+
+        private:
+            Handle m_handle;
+    };
+
+    template<typename T>
+    inline Task<T> TaskPromise<T>::get_return_object() noexcept
+    {
+        return Task<T>(Task<T>::Handle::from_promise(*this));
+    }
+
+    inline Task<void> TaskPromise<void>::get_return_object() noexcept
+    {
+        return Task<void>(Task<void>::Handle::from_promise(*this));
+    }
+}
@@ -1,4 +1,5 @@
 #include "Thread.h"
+#include "ThreadManager.h"
 
 #if defined(SCI_WINDOWS)
 #define NOMINMAX
@@ -44,9 +45,9 @@ void SCI::BAT::Thread::Wait(bool requestStop /*= false*/)
     }
 
     // wait
-    while (!IsFinished())
+    if (m_started)
     {
-        std::this_thread::yield();
+        m_finished.wait(false, std::memory_order::acquire);
     }
 }
 
@@ -60,6 +61,8 @@ void SCI::BAT::Thread::RootThreadMain(std::stop_token stop)
         #elif defined(SCI_LINUX)
         m_tid = gettid();
         #endif
+        m_profile.Attach();
+        ApplyScheduling();
         m_threadReturnCode = ThreadMain();
         m_result = ExecutionResult::StoppedNormaly;
     }
@@ -77,5 +80,26 @@ void SCI::BAT::Thread::RootThreadMain(std::stop_token stop)
     }
 
     // REACHED STOP
+    m_profile.Detach();
     m_finished.test_and_set(std::memory_order::acquire);
+    m_finished.notify_all();
+    NotifyManager();
+}
+
+void SCI::BAT::Thread::ApplyScheduling()
+{
+    // Applied before ThreadMain() so that threads created by the module (workers, pools) inherit the parameters
+    std::string error;
+    if (!m_scheduling.IsDefault() && !m_scheduling.Apply(error))
+    {
+        spdlog::warn("Failed to apply scheduling parameters to thread \"{}\": {}", GetName(), error);
+    }
+}
+
+void SCI::BAT::Thread::NotifyManager()
+{
+    if (m_manager)
+    {
+        m_manager->Notify();
+    }
 }
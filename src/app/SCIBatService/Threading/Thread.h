@@ -5,16 +5,28 @@
   */
 #pragma once
 
+#include <Threading/ThreadProfile.h>
+#include <Threading/ThreadScheduling.h>
+
 #include <spdlog/spdlog.h>
 
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+#include <chrono>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
 #include <exception>
 #include <functional>
 
 namespace SCI::BAT
 {
+    class ThreadManager;
+
     /*!
      * @brief Simple but controllable thread.
      * 
@@ -54,17 +66,18 @@ namespace SCI::BAT
             */
             void Stop();
             /*!
-             * @brief Waits for the thread to be finished.
+             * @brief Waits for the thread to be finished (blocking, without spinning).
              * @param requestStop If true a stop request will be sent prior to waiting.
             */
             void Wait(bool requestStop = false);
 
             /*!
-             * @brief Requests the thread to reload its config.
+             * @brief Requests the thread to reload its config (lock free, wakes the thread).
             */
             inline void ConfigReload()
             {
-                m_confcReq.test_and_set(std::memory_order::acquire);
+                m_configRequested.fetch_add(1, std::memory_order::release);
+                Wake();
             }
 
             /*!
@@ -101,22 +114,13 @@ namespace SCI::BAT
             }
 
             /*!
-             * @brief Checks if this thread should reload its configuration.
+             * @brief Checks if this thread should reload its configuration (only call from the thread itself).
              * @return True if the thread should reload configurations.
             */
             inline bool ConfigReloadRequested()
             {
-                return m_confcReq.test(std::memory_order::acquire);
-            }
-            /*!
-             * @brief Checks if this thread raises a global config reload.
-             * @return True if this thread requested a global config reload.
-            */
-            inline bool ConfigReloadInitiated()
-            {
-                bool init = m_confcInit.test(std::memory_order::acquire);
-                m_confcInit.clear(std::memory_order::release);
-                return init;
+                m_configPending = m_configRequested.load(std::memory_order::acquire);
+                return m_configPending != m_configApplied;
             }
 
             /*!
@@ -130,6 +134,54 @@ namespace SCI::BAT
                 return m_tid;
             }
 
+            /*!
+             * @brief Retrieves the name of the thread.
+             * @return Name (empty if not set)
+            */
+            inline const std::string& GetName() const noexcept
+            {
+                return m_profile.GetName();
+            }
+            /*!
+             * @brief Accesses the profile of the thread (CPU time, context switches, lock waits and loop iterations).
+             * @return Reference to the profile
+            */
+            inline const ThreadProfile& GetProfile() const noexcept
+            {
+                return m_profile;
+            }
+            /*!
+             * @brief Retrieves the scheduling parameters the thread is started with.
+             * @return Scheduling parameters
+            */
+            inline const ThreadScheduling& GetScheduling() const noexcept
+            {
+                return m_scheduling;
+            }
+            /*!
+             * @brief Sets the scheduling parameters (CPU affinity and priority). Only effective before the thread is started.
+             * @param scheduling Scheduling parameters
+            */
+            inline void SetScheduling(ThreadScheduling scheduling)
+            {
+                m_scheduling = std::move(scheduling);
+            }
+
+            /*!
+             * @brief Wakes the thread if it is currently inside Sleep().
+             * 
+             * A wake request issued while the thread is not sleeping will cause the next call to Sleep() to return immediately.
+            */
+            inline void Wake()
+            {
+                {
+                    std::lock_guard lock(m_wakeMutex);
+                    m_wakeRequested = true;
+                }
+                m_wakeCondition.notify_all();
+                OnWake();
+            }
+
             /*!
              * @brief Check weather a system stop request has be raised by this thread.
              * @return True if this threat requested a full system stop.
@@ -142,20 +194,36 @@ namespace SCI::BAT
         protected:
             virtual int ThreadMain() = 0;
             virtual void OnStop() {};
+            /*!
+             * @brief Called by Wake() (from the waking thread). Threads not waiting in Sleep() can use it to forward the wake request.
+            */
+            virtual void OnWake() {};
 
             /*!
-             * @brief Raises a request for a global config change.
+             * @brief Marks that this thread has finished reloading its config.
+             * 
+             * Reload requests made while reloading will cause ConfigReloadRequested() to return true again.
             */
-            inline void RaisConfigChange()
+            inline void DoneConfigChange()
             {
-                m_confcInit.test_and_set(std::memory_order::acquire);
+                m_configApplied = m_configPending;
             }
+
             /*!
-             * @brief Marks that this thread has finished reloading its config.
+             * @brief Names the thread (profiling and operating system). Must be called before the thread is started.
+             * @param name Name of the thread
+            */
+            inline void SetName(std::string name)
+            {
+                m_profile.SetName(std::move(name));
+            }
+            /*!
+             * @brief Accesses the profile of the thread. Use ThreadProfile::Iteration to measure the main loop.
+             * @return Reference to the profile
             */
-            void DoneConfigChange()
+            inline ThreadProfile& GetProfile() noexcept
             {
-                m_confcReq.clear(std::memory_order::release);
+                return m_profile;
             }
 
             /*!
@@ -166,6 +234,30 @@ namespace SCI::BAT
             {
                 return m_stopToken ? m_stopToken->stop_requested() : true;
             }
+            /*!
+             * @brief Retrieves the stop token of the thread (only valid inside ThreadMain()).
+             * @return Stop token
+            */
+            inline std::stop_token GetStopToken() const
+            {
+                return m_stopToken ? *m_stopToken : std::stop_token();
+            }
+
+            /*!
+             * @brief Suspends the thread until the duration elapsed, Wake() was called or a stop was requested.
+             * @tparam Rep Duration representation.
+             * @tparam Period Duration period.
+             * @param duration Maximum time to sleep.
+             * @return True if the thread was woken by Wake() before the duration elapsed.
+            */
+            template<typename Rep, typename Period>
+            bool Sleep(const std::chrono::duration<Rep, Period>& duration)
+            {
+                std::unique_lock lock(m_wakeMutex);
+                bool woken = m_wakeCondition.wait_for(lock, m_stopToken ? *m_stopToken : std::stop_token(), duration, [this]() { return m_wakeRequested; });
+                m_wakeRequested = false;
+                return woken;
+            }
 
             /*!
              * @brief Initiates a global system stop request.
@@ -173,10 +265,15 @@ namespace SCI::BAT
             inline void RaisSystemStopRequest()
             {
                 m_sysStopReq.test_and_set(std::memory_order::acquire);
+                NotifyManager();
             }
 
         private:
             void RootThreadMain(std::stop_token stop);
+            void ApplyScheduling();
+            void NotifyManager();
+
+            friend class ThreadManager;
 
         private:
             bool m_started = false;
@@ -188,10 +285,19 @@ namespace SCI::BAT
             std::string m_exceptionText;
             int m_threadReturnCode = -1;
 
+            ThreadProfile m_profile;
+            ThreadScheduling m_scheduling;
+
             std::stop_token* m_stopToken = nullptr;
+            ThreadManager* m_manager = nullptr;
 
-            std::atomic_flag m_confcInit;
-            std::atomic_flag m_confcReq;
+            std::atomic<uint64_t> m_configRequested = 0;
+            uint64_t m_configPending = 0;
+            uint64_t m_configApplied = 0;
             std::atomic_flag m_sysStopReq;
+
+            std::mutex m_wakeMutex;
+            std::condition_variable_any m_wakeCondition;
+            bool m_wakeRequested = false;
     };
 }
@@ -1,14 +1,29 @@
 #include "ThreadManager.h"
 
+#if defined(SCI_LINUX)
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+
 SCI::BAT::ThreadManager::ThreadManager()
 {
-
+    #if defined(SCI_LINUX)
+    m_eventFd = eventfd(0, EFD_CLOEXEC);
+    SCI_ASSERT_FMT(m_eventFd >= 0, "Failed to create eventfd (errno {})", errno);
+    #endif
 }
 
 SCI::BAT::ThreadManager::~ThreadManager()
 {
     Stop();
     Wait();
+
+    #if defined(SCI_LINUX)
+    if (m_eventFd >= 0)
+    {
+        close(m_eventFd);
+    }
+    #endif
 }
 
 void SCI::BAT::ThreadManager::Stop()
@@ -28,6 +43,13 @@ void SCI::BAT::ThreadManager::Start()
 {
     if (m_status == Status::Prepared)
     {
+        // Lock memory before the threads allocate their stacks
+        std::string error;
+        if (m_lockMemory && !ThreadScheduling::LockMemory(error))
+        {
+            spdlog::warn("Failed to lock memory: {}", error);
+        }
+
         for (auto* thread : m_threads)
         {
             thread->Start();
@@ -58,44 +80,69 @@ void SCI::BAT::ThreadManager::Register(Thread& thread)
 {
     if (m_status == Status::Prepared)
     {
+        thread.m_manager = this;
         m_threads.push_back(&thread);
     }
 }
 
-void SCI::BAT::ThreadManager::Wait()
+void SCI::BAT::ThreadManager::ConfigureScheduling(const nlohmann::json& config)
 {
-    if (m_status == Status::Stoped)
+    if (m_status == Status::Prepared && config.is_object())
     {
-        // Wait for all threads
+        m_lockMemory = config.value("lock-memory", false);
         for (auto* thread : m_threads)
         {
-            thread->Wait();
+            auto itThread = config.find(thread->GetName());
+            if (!thread->GetName().empty() && itThread != config.end())
+            {
+                thread->SetScheduling(ThreadScheduling::FromJson(*itThread));
+            }
         }
     }
 }
 
-void SCI::BAT::ThreadManager::Update()
+void SCI::BAT::ThreadManager::Wait()
 {
-    // Check if release is request
-    bool doConfig = false;
-    for (auto* thread : m_threads)
+    if (m_status == Status::Stoped)
     {
-        if (thread->ConfigReloadInitiated())
+        // Wait for all threads
+        for (auto* thread : m_threads)
         {
-            ;
-            doConfig = true;
-            break;
+            thread->Wait();
         }
     }
+}
 
-    // Set config flags on all threads
-    if (doConfig)
+void SCI::BAT::ThreadManager::WaitForEvent()
+{
+    // Returns immediately if events were raised after the last call
+    #if defined(SCI_LINUX)
+    uint32_t events = m_events.load(std::memory_order::acquire);
+    while (events == m_eventsSeen)
     {
-        for (auto* thread : m_threads)
-        {
-            thread->ConfigReload();
-        }
+        // Blocks until Notify() wrote to the eventfd (or a signal interrupted the read)
+        uint64_t value;
+        [[maybe_unused]] auto bytesRead = read(m_eventFd, &value, sizeof(value));
+        events = m_events.load(std::memory_order::acquire);
     }
+    m_eventsSeen = events;
+    #else
+    m_events.wait(m_eventsSeen, std::memory_order::acquire);
+    m_eventsSeen = m_events.load(std::memory_order::acquire);
+    #endif
+}
+
+void SCI::BAT::ThreadManager::Notify() noexcept
+{
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "The event counter must be lock free to be raised from signal handlers");
+    m_events.fetch_add(1, std::memory_order::release);
+    #if defined(SCI_LINUX)
+    // write() is async signal safe, std::atomic::notify_all() is not
+    uint64_t value = 1;
+    [[maybe_unused]] auto bytesWritten = write(m_eventFd, &value, sizeof(value));
+    #else
+    m_events.notify_all();
+    #endif
 }
 
 bool SCI::BAT::ThreadManager::HasSystemStopRequest() const
@@ -6,8 +6,17 @@
 #pragma once
 
 #include <Threading/Thread.h>
+#include <Threading/ThreadScheduling.h>
 
+#include <SCIUtil/Exception.h>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <cstdint>
 #include <vector>
+#include <string>
+#include <string_view>
 
 namespace SCI::BAT
 {
@@ -33,11 +42,11 @@ namespace SCI::BAT
         public:
             ThreadManager();
             ThreadManager(const ThreadManager&) = delete;
-            ThreadManager(ThreadManager&& other) noexcept = default;
+            ThreadManager(ThreadManager&& other) noexcept = delete;
             ~ThreadManager();
             
             ThreadManager& operator=(const ThreadManager&) = delete;
-            ThreadManager& operator=(ThreadManager&& other) noexcept = default;
+            ThreadManager& operator=(ThreadManager&& other) noexcept = delete;
 
             /*!
              * @brief Registers a thread with this ThreadManager.
@@ -45,6 +54,14 @@ namespace SCI::BAT
             */
             void Register(Thread& thread);
 
+            /*!
+             * @brief Sets the scheduling parameters of the managed threads. Only effective before Start().
+             * 
+             * Format: { "lock-memory": false, "<thread name>": { "cpus": [], "realtime-priority": 0, "nice": 0 }, ... }. Threads not listed keep their parameters.
+             * @param config Scheduling configuration
+            */
+            void ConfigureScheduling(const nlohmann::json& config);
+
             /*!
              * @brief Starts the execution of all managed threads.
             */
@@ -59,9 +76,18 @@ namespace SCI::BAT
             void Wait();
 
             /*!
-             * @brief Performs a single thread synchronization step.
+             * @brief Blocks until an event occurred since the last call.
+             * 
+             * Events are raised by the managed threads (thread finished, system stop request) and by Notify().
+            */
+            void WaitForEvent();
+            /*!
+             * @brief Raises an event and wakes WaitForEvent().
+             * 
+             * May be called from any thread. Async signal safe on Linux (only a lock free increment and a write to an eventfd, the waiting thread
+             * is woken by the kernel). Windows runs console signal handlers on a separate thread, which may wake the waiter directly.
             */
-            void Update();
+            void Notify() noexcept;
 
             /*!
              * @brief Checks if one or multiple threads requested a global system stop.
@@ -76,19 +102,12 @@ namespace SCI::BAT
             size_t IsRunning();
 
             /*!
-             * @brief Execution operator for incremental synchronization. 
-             * 
-             * Will call Update() when threads are running.
+             * @brief Execution operator for the main loop.
              * @return Returns true as long as at minimum thread in running.
             */
             inline size_t operator()()
             {
-                if (IsRunning())
-                {
-                    Update();
-                    return true;
-                }
-                return false;
+                return IsRunning() > 0;
             }
 
             /*!
@@ -105,6 +124,13 @@ namespace SCI::BAT
         private:
             Status m_status = Status::Prepared;
             std::vector<Thread*> m_threads;
+            bool m_lockMemory = false;
+
+            std::atomic<uint32_t> m_events = 0;
+            uint32_t m_eventsSeen = 0;
+            #if defined(SCI_LINUX)
+            int m_eventFd = -1;
+            #endif
     };
 }
 
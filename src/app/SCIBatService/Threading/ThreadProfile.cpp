@@ -0,0 +1,138 @@
+#include "ThreadProfile.h"
+
+#if defined(SCI_WINDOWS)
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(SCI_LINUX)
+#include <unistd.h>
+#include <sys/resource.h>
+#include <fstream>
+#endif
+
+std::mutex SCI::BAT::ThreadProfile::s_registryMutex;
+SCI::BAT::ThreadProfile* SCI::BAT::ThreadProfile::s_registryHead = nullptr;
+
+SCI::BAT::ThreadProfile::ThreadProfile()
+{
+    std::lock_guard janitor(s_registryMutex);
+    m_next = s_registryHead;
+    if (m_next)
+    {
+        m_next->m_prev = this;
+    }
+    s_registryHead = this;
+}
+
+SCI::BAT::ThreadProfile::~ThreadProfile()
+{
+    std::lock_guard janitor(s_registryMutex);
+    if (m_prev)
+    {
+        m_prev->m_next = m_next;
+    }
+    else
+    {
+        s_registryHead = m_next;
+    }
+    if (m_next)
+    {
+        m_next->m_prev = m_prev;
+    }
+}
+
+void SCI::BAT::ThreadProfile::Attach()
+{
+    #if defined(SCI_WINDOWS)
+    m_tid = (int)GetCurrentThreadId();
+    #elif defined(SCI_LINUX)
+    m_tid = gettid();
+    pthread_getcpuclockid(pthread_self(), &m_cpuClock);
+    if (!m_name.empty())
+    {
+        // Visible in top / htop (limited to 15 characters)
+        pthread_setname_np(pthread_self(), m_name.substr(0, 15).c_str());
+    }
+    #endif
+
+    Util::LockWait::Attach(&m_lockWait);
+    if (!m_name.empty())
+    {
+        Util::Tracer::SetThreadName(m_name);
+    }
+    m_running.store(true, std::memory_order::release);
+}
+
+void SCI::BAT::ThreadProfile::Detach()
+{
+    #if defined(SCI_LINUX)
+    rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0)
+    {
+        auto cpuTime = std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+        m_finalCpuTime = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(cpuTime).count();
+        m_finalVoluntarySwitches = (uint64_t)usage.ru_nvcsw;
+        m_finalInvoluntarySwitches = (uint64_t)usage.ru_nivcsw;
+    }
+    #endif
+
+    Util::LockWait::Attach(nullptr);
+    m_running.store(false, std::memory_order::release);
+}
+
+SCI::BAT::ThreadProfile::Snapshot SCI::BAT::ThreadProfile::Read() const
+{
+    Snapshot snapshot;
+    snapshot.name = m_name;
+    snapshot.tid = m_tid;
+    snapshot.running = m_running.load(std::memory_order::acquire);
+    snapshot.lockWait = m_lockWait.load(std::memory_order::relaxed);
+    snapshot.iterations = m_iterations.load(std::memory_order::relaxed);
+    snapshot.iterationTime = m_iterationTime.Read();
+
+    // The thread may exit while reading. The final values are stored before it reports not running
+    if (!snapshot.running || !ReadSystemCounters(snapshot.cpuTime, snapshot.voluntarySwitches, snapshot.involuntarySwitches))
+    {
+        snapshot.cpuTime = m_finalCpuTime;
+        snapshot.voluntarySwitches = m_finalVoluntarySwitches;
+        snapshot.involuntarySwitches = m_finalInvoluntarySwitches;
+    }
+    return snapshot;
+}
+
+void SCI::BAT::ThreadProfile::ForEach(const std::function<void(const ThreadProfile&)>& f)
+{
+    std::lock_guard janitor(s_registryMutex);
+    for (auto* profile = s_registryHead; profile; profile = profile->m_next)
+    {
+        f(*profile);
+    }
+}
+
+bool SCI::BAT::ThreadProfile::ReadSystemCounters(uint64_t& cpuTime, uint64_t& voluntarySwitches, uint64_t& involuntarySwitches) const
+{
+    #if defined(SCI_LINUX)
+    timespec cpuClock;
+    if (clock_gettime(m_cpuClock, &cpuClock) != 0)
+    {
+        return false;
+    }
+    cpuTime = (uint64_t)cpuClock.tv_sec * 1000000000 + (uint64_t)cpuClock.tv_nsec;
+
+    std::ifstream status("/proc/self/task/" + std::to_string(m_tid.load()) + "/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.starts_with("voluntary_ctxt_switches:"))
+        {
+            voluntarySwitches = std::stoull(line.substr(line.find(':') + 1));
+        }
+        else if (line.starts_with("nonvoluntary_ctxt_switches:"))
+        {
+            involuntarySwitches = std::stoull(line.substr(line.find(':') + 1));
+        }
+    }
+    return true;
+    #else
+    return false;
+    #endif
+}
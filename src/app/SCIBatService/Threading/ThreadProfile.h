@@ -0,0 +1,171 @@
+ /*!
+  * @file ThreadProfile.h
+  * @brief CPU, iteration and lock wait profile of a thread.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <SCIUtil/Metrics/Histogram.h>
+#include <SCIUtil/Concurrent/LockWait.h>
+#include <SCIUtil/Trace/Tracer.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#if defined(SCI_LINUX)
+#include <pthread.h>
+#include <time.h>
+#endif
+
+namespace SCI::BAT
+{
+    /*!
+     * @brief Profile of a single thread. Written by the profiled thread, readable by everyone.
+     *
+     * CPU time and context switches are read from the operating system on demand, so the profiled thread pays nothing for them.
+     * All profiles alive are registered and can be enumerated via ForEach().
+    */
+    class ThreadProfile
+    {
+        public:
+            /*!
+             * @brief Values of a profile at one point in time
+            */
+            struct Snapshot
+            {
+                /*! Name of the thread */
+                std::string name;
+                /*! Operating system thread id (-1 if never started) */
+                int tid = -1;
+                /*! Thread is executing */
+                bool running = false;
+                /*! CPU time consumed (user + system, nanoseconds) */
+                uint64_t cpuTime = 0;
+                /*! Voluntary context switches (waits) */
+                uint64_t voluntarySwitches = 0;
+                /*! Involuntary context switches (preemptions) */
+                uint64_t involuntarySwitches = 0;
+                /*! Time spent waiting for contended locks (nanoseconds) */
+                uint64_t lockWait = 0;
+                /*! Completed loop iterations */
+                uint64_t iterations = 0;
+                /*! Duration of the loop iterations (microseconds) */
+                Util::Histogram::Snapshot iterationTime;
+            };
+
+            /*!
+             * @brief Measures one loop iteration from construction until End() or destruction
+            */
+            class Iteration
+            {
+                public:
+                    Iteration(ThreadProfile& profile) :
+                        m_profile(&profile)
+                    {}
+                    Iteration(const Iteration&) = delete;
+                    Iteration(Iteration&&) noexcept = delete;
+                    ~Iteration()
+                    {
+                        End();
+                    }
+
+                    Iteration& operator=(const Iteration&) = delete;
+                    Iteration& operator=(Iteration&&) noexcept = delete;
+
+                    /*!
+                     * @brief Ends the iteration (call before waiting for the next one)
+                    */
+                    inline void End()
+                    {
+                        if (m_profile)
+                        {
+                            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start);
+                            m_profile->m_iterationTime.Record((uint64_t)duration.count());
+                            m_profile->m_iterations.fetch_add(1, std::memory_order::relaxed);
+                            m_profile = nullptr;
+                        }
+                    }
+
+                private:
+                    ThreadProfile* m_profile;
+                    std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+            };
+
+        public:
+            ThreadProfile();
+            ThreadProfile(const ThreadProfile&) = delete;
+            ThreadProfile(ThreadProfile&&) noexcept = delete;
+            ~ThreadProfile();
+
+            ThreadProfile& operator=(const ThreadProfile&) = delete;
+            ThreadProfile& operator=(ThreadProfile&&) noexcept = delete;
+
+            /*!
+             * @brief Sets the name of the profile. Must be called before the thread is attached.
+             * @param name Name of the thread
+            */
+            inline void SetName(std::string name)
+            {
+                m_name = std::move(name);
+            }
+            /*!
+             * @brief Retrieves the name of the profile
+             * @return Name
+            */
+            inline const std::string& GetName() const noexcept
+            {
+                return m_name;
+            }
+
+            /*!
+             * @brief Binds the profile to the calling thread (also names the thread on the operating system level)
+            */
+            void Attach();
+            /*!
+             * @brief Stores the final values and unbinds the profile. Must be called by the profiled thread.
+            */
+            void Detach();
+
+            /*!
+             * @brief Reads the current values (callable from any thread)
+             * @return Snapshot
+            */
+            Snapshot Read() const;
+
+            /*!
+             * @brief Calls f for every profile alive
+             * @param f Callback function
+            */
+            static void ForEach(const std::function<void(const ThreadProfile&)>& f);
+
+        private:
+            bool ReadSystemCounters(uint64_t& cpuTime, uint64_t& voluntarySwitches, uint64_t& involuntarySwitches) const;
+
+        private:
+            std::string m_name;
+            std::atomic<int> m_tid = -1;
+            std::atomic_bool m_running = false;
+            #if defined(SCI_LINUX)
+            clockid_t m_cpuClock = 0;
+            #endif
+
+            // Final values (valid after Detach())
+            std::atomic<uint64_t> m_finalCpuTime = 0;
+            std::atomic<uint64_t> m_finalVoluntarySwitches = 0;
+            std::atomic<uint64_t> m_finalInvoluntarySwitches = 0;
+
+            std::atomic<uint64_t> m_lockWait = 0;
+            std::atomic<uint64_t> m_iterations = 0;
+            Util::Histogram m_iterationTime;
+
+            ThreadProfile* m_prev = nullptr;
+            ThreadProfile* m_next = nullptr;
+
+            static std::mutex s_registryMutex;
+            static ThreadProfile* s_registryHead;
+    };
+}
@@ -0,0 +1,153 @@
+#include "ThreadScheduling.h"
+
+#include <fmt/format.h>
+
+#if defined(SCI_WINDOWS)
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(SCI_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <cstring>
+#include <cerrno>
+#endif
+
+bool SCI::BAT::ThreadScheduling::Apply(std::string& error) const
+{
+    #if defined(SCI_WINDOWS)
+    if (!cpus.empty())
+    {
+        DWORD_PTR mask = 0;
+        for (int cpu : cpus)
+        {
+            if (cpu < 0 || cpu >= (int)(sizeof(DWORD_PTR) * 8))
+            {
+                error = fmt::format("Invalid cpu {}", cpu);
+                return false;
+            }
+            mask |= (DWORD_PTR)1 << cpu;
+        }
+        if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+        {
+            error = fmt::format("SetThreadAffinityMask failed with code {}", GetLastError());
+            return false;
+        }
+    }
+
+    // Windows has no per thread nice value. The nice value is mapped to the nearest thread priority
+    int priority = THREAD_PRIORITY_NORMAL;
+    if (realtimePriority > 0)
+        priority = THREAD_PRIORITY_TIME_CRITICAL;
+    else if (nice <= -10)
+        priority = THREAD_PRIORITY_HIGHEST;
+    else if (nice < 0)
+        priority = THREAD_PRIORITY_ABOVE_NORMAL;
+    else if (nice >= 10)
+        priority = THREAD_PRIORITY_LOWEST;
+    else if (nice > 0)
+        priority = THREAD_PRIORITY_BELOW_NORMAL;
+    if (priority != THREAD_PRIORITY_NORMAL && !SetThreadPriority(GetCurrentThread(), priority))
+    {
+        error = fmt::format("SetThreadPriority failed with code {}", GetLastError());
+        return false;
+    }
+    #elif defined(SCI_LINUX)
+    if (!cpus.empty())
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (int cpu : cpus)
+        {
+            if (cpu < 0 || cpu >= CPU_SETSIZE)
+            {
+                error = fmt::format("Invalid cpu {}", cpu);
+                return false;
+            }
+            CPU_SET(cpu, &cpuSet);
+        }
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if (rc != 0)
+        {
+            error = fmt::format("Setting the cpu affinity failed: {}", strerror(rc));
+            return false;
+        }
+    }
+
+    if (realtimePriority > 0)
+    {
+        sched_param param{};
+        param.sched_priority = realtimePriority;
+        if (realtimePriority < sched_get_priority_min(SCHED_FIFO) || realtimePriority > sched_get_priority_max(SCHED_FIFO))
+        {
+            error = fmt::format("Invalid realtime priority {}", realtimePriority);
+            return false;
+        }
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0)
+        {
+            error = fmt::format("Setting SCHED_FIFO priority {} failed: {}", realtimePriority, strerror(rc));
+            return false;
+        }
+    }
+    else if (nice != 0)
+    {
+        // On Linux the nice value is a property of the thread (not the process)
+        if (setpriority(PRIO_PROCESS, (id_t)gettid(), nice) != 0)
+        {
+            error = fmt::format("Setting nice value {} failed: {}", nice, strerror(errno));
+            return false;
+        }
+    }
+    #endif
+
+    return true;
+}
+
+SCI::BAT::ThreadScheduling SCI::BAT::ThreadScheduling::FromJson(const nlohmann::json& json)
+{
+    ThreadScheduling scheduling;
+    if (json.is_object())
+    {
+        auto itCpus = json.find("cpus");
+        if (itCpus != json.end() && itCpus->is_array())
+        {
+            for (const auto& cpu : *itCpus)
+            {
+                if (cpu.is_number_integer())
+                {
+                    scheduling.cpus.push_back(cpu.get<int>());
+                }
+            }
+        }
+        scheduling.realtimePriority = json.value("realtime-priority", 0);
+        scheduling.nice = json.value("nice", 0);
+    }
+    return scheduling;
+}
+
+nlohmann::json SCI::BAT::ThreadScheduling::ToJson() const
+{
+    return {
+        { "cpus", cpus },
+        { "realtime-priority", realtimePriority },
+        { "nice", nice },
+    };
+}
+
+bool SCI::BAT::ThreadScheduling::LockMemory(std::string& error)
+{
+    #if defined(SCI_LINUX)
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        error = fmt::format("mlockall failed: {}", strerror(errno));
+        return false;
+    }
+    return true;
+    #else
+    error = "Memory locking is not supported on this platform";
+    return false;
+    #endif
+}
@@ -0,0 +1,62 @@
+ /*!
+  * @file ThreadScheduling.h
+  * @brief CPU affinity and scheduling priority of a thread.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+#include <vector>
+
+namespace SCI::BAT
+{
+    /*!
+     * @brief Scheduling parameters of a thread. Threads created by the thread afterwards inherit them.
+    */
+    struct ThreadScheduling
+    {
+        /*! CPUs the thread may run on (empty: all CPUs) */
+        std::vector<int> cpus;
+        /*! SCHED_FIFO priority (1 - 99, 0: regular scheduling) */
+        int realtimePriority = 0;
+        /*! Nice value of the thread (-20 - 19, only used with regular scheduling) */
+        int nice = 0;
+
+        /*!
+         * @brief Checks if the parameters differ from the operating systems defaults
+         * @return True if Apply() has something to do
+        */
+        inline bool IsDefault() const noexcept
+        {
+            return cpus.empty() && realtimePriority == 0 && nice == 0;
+        }
+
+        /*!
+         * @brief Applies the parameters to the calling thread
+         * @param error Receives the reason of a failure (missing privileges are the usual one)
+         * @return True if all parameters were applied
+        */
+        bool Apply(std::string& error) const;
+
+        /*!
+         * @brief Reads the parameters from json ({ "cpus": [0, 1], "realtime-priority": 0, "nice": 0 }, missing values keep their default)
+         * @param json Json object
+         * @return Scheduling parameters
+        */
+        static ThreadScheduling FromJson(const nlohmann::json& json);
+        /*!
+         * @brief Converts the parameters to json (format of FromJson())
+         * @return Json object
+        */
+        nlohmann::json ToJson() const;
+
+        /*!
+         * @brief Locks all current and future memory pages of the process in RAM (no page faults in the control loops)
+         * @param error Receives the reason of a failure
+         * @return True on success
+        */
+        static bool LockMemory(std::string& error);
+    };
+}
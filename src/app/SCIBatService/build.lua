@@ -2,7 +2,7 @@
 reti_new_project("SCIBatService", "src/app/SCIBatService")
 reti_executable()
 reti_cpp()
-links { "SCIUtil", "NetTools", "ModbusMaster" }
+links { "ModbusMaster", "NetTools", "SCIUtil" }
 
 webserver_root = "%{wks.location}/etc/sci-bat-app-dir"
 targetname("sci-bat-service")
@@ -7,6 +7,7 @@
 #include <Config/UqlJson.h>
 #include <Config/AuthenticatedConfig.h>
 #include <Threading/ThreadManager.h>
+#include <Threading/Executor.h>
 
 #include <Modules/SCIBatWebserver.h>
 #include <Modules/Mailbox/MailboxThread.h>
@@ -16,13 +17,18 @@
 
 #include <SCIUtil/Exception.h>
 #include <SCIUtil/KeyboardInterrupt.h>
+#include <SCIUtil/Trace/Tracer.h>
 
 #include <Vendor/serialib.h>
 #include <pugixml.hpp>
 #include <argparse/argparse.hpp>
+#include <SCIUtil/Logging/BinaryLogSink.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <sodium.h>
 
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <string_view>
@@ -64,14 +70,87 @@ namespace SCI::BAT
             .implicit_value(true)
             ;
         args.add_argument("-t", "--trace")
-            .help("Enables trace outputs (big logs)")
+            .help("Enables trace outputs (big logs, trace messages are only compiled into debug builds)")
             .default_value(false)
             .implicit_value(true)
             ;
+
+        args.add_argument("--trace-spans")
+            .help("Records trace spans from startup (export and switch at /api/trace)")
+            .default_value(false)
+            .implicit_value(true)
+            ;
+
+        // Logging backend
+        args.add_argument<std::string>("--log-file")
+            .help("Additionally writes all messages to a binary log (decode with LogDecoder)")
+            .default_value<std::string>("")
+            ;
+        args.add_argument("--log-queue")
+            .help("Number of messages the asynchronous logger can buffer")
+            .default_value<size_t>(8192)
+            .scan<'u', size_t>()
+            ;
+        args.add_argument("--log-block")
+            .help("Blocks logging threads when the queue is full (default: the oldest messages are dropped)")
+            .default_value(false)
+            .implicit_value(true)
+            ;
+
+        // Shared executor
+        args.add_argument("--executor-workers")
+            .help("Number of threads executing the housekeeping and event driven work of the modules (the executor thread and additional workers)")
+            .default_value<size_t>(1)
+            .scan<'u', size_t>()
+            ;
+
+        // Config database durability
+        args.add_argument<std::string>("--db-durability")
+            .help("When settings are committed: \"sync\" (every write), \"group\" (together with the writes of the commit interval) or \"memory\" (periodic checkpoint)")
+            .default_value<std::string>("group")
+            ;
+        args.add_argument("--db-commit-interval")
+            .help("Milliseconds between two commits of the \"group\" and \"memory\" durability (zero selects 1000 for \"group\" and 300000 for \"memory\")")
+            .default_value<unsigned int>(0)
+            .scan<'u', unsigned int>()
+            ;
+
+        // Config snapshots
+        args.add_argument<std::string>("--export")
+            .help("Writes a snapshot of the configuration database to the file and exits")
+            .default_value<std::string>("")
+            ;
+        args.add_argument<std::string>("--import")
+            .help("Imports a snapshot of the configuration database before starting (all settings or none)")
+            .default_value<std::string>("")
+            ;
+    }
+
+    /*!
+     * @brief Starts the logging backend and creates the sinks shared by all loggers.
+     * @param args ArgumentParser that contains configured logger information.
+     * @return Sinks for the loggers.
+    */
+    std::vector<spdlog::sink_ptr> CreateLogSinks(const argparse::ArgumentParser& args)
+    {
+        // Messages are formatted and written by the backend thread. The queue is allocated once
+        spdlog::init_thread_pool(args.get<size_t>("--log-queue"), 1);
+        spdlog::flush_every(std::chrono::seconds(1));
+
+        std::vector<spdlog::sink_ptr> sinks;
+        sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+        auto logFile = args.get<std::string>("--log-file");
+        if (!logFile.empty())
+        {
+            sinks.push_back(std::make_shared<SCI::Util::BinaryLogSink>(logFile));
+        }
+        return sinks;
     }
 
     /*!
      * @brief Creates an SPDLog-Logger.
+     * 
+     * Loggers are asynchronous: The calling thread only formats the message arguments and queues the message.
      * @param args ArgumentParser that contains configured logger information.
      * @param name Name of the logger.
      * @return SPDLog logger pointer.
@@ -79,7 +158,10 @@ namespace SCI::BAT
     auto CreateLogger(const argparse::ArgumentParser& args, const char* name)
     {
         // Create logger
-        auto logger = spdlog::stdout_color_mt(name);
+        static std::vector<spdlog::sink_ptr> sinks = CreateLogSinks(args);
+        auto overflowPolicy = args["--log-block"] == true ? spdlog::async_overflow_policy::block : spdlog::async_overflow_policy::overrun_oldest;
+        auto logger = std::make_shared<spdlog::async_logger>(name, sinks.begin(), sinks.end(), spdlog::thread_pool(), overflowPolicy);
+        spdlog::register_logger(logger);
 
         // Configure logger
         if (args["-t"] == true)
@@ -91,19 +173,28 @@ namespace SCI::BAT
             logger->set_level(spdlog::level::debug);
         }
         logger->set_pattern("[%d.%m.%Y %H:%M:%S.%e] [%^%l%$] [%t] [%n] %v");
+        logger->flush_on(spdlog::level::warn);
 
         return logger;
     }
 
     /*!
      * @brief Helper for creating a user in the database.
+     * @param defaults Startup transaction of all defaults.
      * @param usernamen Username of the user to be created. If the user already exists this function will do nothing.
      * @param authlevel Permision level of the user.
      * @param enabled Enable state of the user. If true the user can login.
     */
-    void CreateUser(const std::string& usernamen, int authlevel, bool enabled = true)
+    void CreateUser(Config::AuthenticateConfig::Transaction& defaults, const std::string& usernamen, int authlevel, bool enabled = true)
     {
-        Config::AuthenticateConfig::InsertData("user." + usernamen, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Unauthenticated, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::SuperAdmin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System,
+        // Checked first: Hashing the password dominates the startup time (only done for missing users)
+        Config::AuthenticateConfig::Permissions permissions;
+        if (Config::AuthenticateConfig::GetPermissions("user." + usernamen, permissions))
+        {
+            return;
+        }
+
+        defaults.Insert("user." + usernamen, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Unauthenticated, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::SuperAdmin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System,
             {
                 { "username", usernamen },
                 { "password", SCI::BAT::Webserver::HTTPAuthentication::HashPassword(usernamen) },
@@ -123,6 +214,7 @@ namespace SCI::BAT
         // Extract arguments
         const std::filesystem::path appDirectory = args.get<std::string>("-a");
         const std::filesystem::path confDirectory = args.get<std::string>("-c");
+        Util::Tracer::SetEnabled(args["--trace-spans"] == true);
 
         // Init sodium
         auto sodiumrc = sodium_init();
@@ -135,14 +227,94 @@ namespace SCI::BAT
         // Init settings db (data.db)
         auto settingDbPath = confDirectory / "data.db";
         spdlog::info("Inisialising systems configuration database {}", settingDbPath.generic_string());
+        auto dbDurabilityName = args.get<std::string>("--db-durability");
+        auto dbDurability = Config::UqlJson::Durability::Sync;
+        auto dbCommitInterval = std::chrono::milliseconds(args.get<unsigned int>("--db-commit-interval"));
+        if (dbDurabilityName == "group")
+        {
+            dbDurability = Config::UqlJson::Durability::GroupCommit;
+            dbCommitInterval = dbCommitInterval.count() ? dbCommitInterval : std::chrono::milliseconds(1000);
+        }
+        else if (dbDurabilityName == "memory")
+        {
+            dbDurability = Config::UqlJson::Durability::Memory;
+            dbCommitInterval = dbCommitInterval.count() ? dbCommitInterval : std::chrono::milliseconds(300000);
+        }
+        else
+        {
+            SCI_ASSERT_FMT(dbDurabilityName == "sync", "Unknown config database durability \"{}\"", dbDurabilityName);
+        }
+        Config::UqlJson::Get().SetDurability(dbDurability);
         Config::UqlJson::Get().Init(settingDbPath);
 
-        // Add default configuration (insert will fail when already in there)
+        // Module schemas (validate the snapshot import and all later writes)
+        SCI::BAT::Mailbox::MailboxThread::RegisterConfigSchema();
+        SCI::BAT::Gateway::GatewayThread::RegisterConfigSchema();
+        SCI::BAT::TControle::TControlThread::RegisterConfigSchema();
+
+        // Restore a snapshot (before the defaults are inserted)
+        auto importFile = args.get<std::string>("--import");
+        if (!importFile.empty())
+        {
+            spdlog::info("Importing configuration snapshot {}", importFile);
+            std::ifstream importStream(importFile, std::ios::binary);
+            SCI_ASSERT_FMT(importStream, "Failed to open configuration snapshot {}", importFile);
+            std::string error;
+            size_t imported = Config::AuthenticateConfig::ImportSnapshot(importStream, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, error);
+            SCI_ASSERT_FMT(error.empty(), "Failed to import configuration snapshot {} ({})", importFile, error);
+            spdlog::info("Imported {} settings", imported);
+        }
+
+        // Add default configuration in one commit (existing settings are skipped, the modules only read their config)
         spdlog::info("Configuring default settings");
-        CreateUser("superadmin", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::SuperAdmin);
-        CreateUser("admin", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, false);
-        CreateUser("operator", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Operator, false);
-        CreateUser("viewer", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Viewer, false);
+        Config::AuthenticateConfig::Transaction defaults((int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System);
+        CreateUser(defaults, "superadmin", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::SuperAdmin);
+        CreateUser(defaults, "admin", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, false);
+        CreateUser(defaults, "operator", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Operator, false);
+        CreateUser(defaults, "viewer", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Viewer, false);
+        SCI::BAT::Mailbox::MailboxThread::InsertDefaultConfig(defaults);
+        SCI::BAT::Gateway::GatewayThread::InsertDefaultConfig(defaults);
+        SCI::BAT::TControle::TControlThread::InsertDefaultConfig(defaults);
+
+        // Scheduling of the module threads (applied at thread start, web traffic must not delay the control loops)
+        nlohmann::json threadsDefaults = { { "lock-memory", false } };
+        for (const char* thread : { "executor", "webserver", "mailbox", "gateway", "tcontrol" })
+        {
+            threadsDefaults[thread] = SCI::BAT::ThreadScheduling{}.ToJson();
+        }
+        threadsDefaults["webserver"] = SCI::BAT::ThreadScheduling{ .nice = 5 }.ToJson();
+        defaults.Insert("threads", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::Admin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::SuperAdmin, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, threadsDefaults);
+        SCI_ASSERT(defaults.Commit() == Config::AuthenticateConfig::Transaction::CommitResult::Committed, "Failed to store the default settings");
+        spdlog::info("Inserted {} default settings", defaults.GetKeys().size());
+
+        // Write a snapshot and exit
+        auto exportFile = args.get<std::string>("--export");
+        if (!exportFile.empty())
+        {
+            spdlog::info("Exporting configuration snapshot {}", exportFile);
+            std::ofstream exportStream(exportFile, std::ios::binary | std::ios::trunc);
+            SCI_ASSERT_FMT(exportStream, "Failed to create configuration snapshot {}", exportFile);
+            size_t exported = Config::AuthenticateConfig::ExportSnapshot(exportStream, (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System);
+            spdlog::info("Exported {} settings", exported);
+            return 0;
+        }
+
+        // Create shared executor (periodic and event driven work of all modules)
+        spdlog::info("Loading Executor");
+        auto executorWorkers = args.get<size_t>("--executor-workers");
+        SCI_ASSERT(executorWorkers > 0, "The executor needs at least one worker");
+        SCI::BAT::Executor executor(executorWorkers, CreateLogger(args, "executor"));
+        if (dbDurability != Config::UqlJson::Durability::Sync)
+        {
+            spdlog::info("Committing settings every {}ms ({})", dbCommitInterval.count(), dbDurabilityName);
+            executor.Periodic(dbCommitInterval, []()
+                {
+                    if (!Config::UqlJson::Get().Checkpoint())
+                    {
+                        spdlog::warn("Failed to commit {} staged settings (retrying with the next checkpoint)", Config::UqlJson::Get().GetStats().pending);
+                    }
+                }, SCI::BAT::Executor::Priority::Low);
+        }
 
         // Create Webserver module
         spdlog::info("Loading Webserver");
@@ -167,7 +339,7 @@ namespace SCI::BAT
 
         // Create mailbox module
         spdlog::info("Configuring MQTT Mailbox");
-        SCI::BAT::Mailbox::MailboxThread mailbox(CreateLogger(args, "mailbox"));
+        SCI::BAT::Mailbox::MailboxThread mailbox(confDirectory / "mailbox.spool", CreateLogger(args, "mailbox"));
 
         // Create gateway module
         spdlog::info("Loading Modbus <---> MQTT Gateway");
@@ -180,7 +352,15 @@ namespace SCI::BAT
         // Manage the threads
         spdlog::info("Loading ThreadManager");
         SCI::BAT::ThreadManager tmgr;
-        tmgr << webserver << mailbox << gateway << tcontrol;
+        tmgr << executor << webserver << mailbox << gateway << tcontrol;
+
+        // Scheduling of the module threads (see the "threads" default setting)
+        spdlog::info("Configuring thread scheduling");
+        nlohmann::json threadsConfig;
+        if (Config::AuthenticateConfig::ReadData("threads", (int)SCI::BAT::Webserver::HTTPUser::PermissionLevel::System, threadsConfig))
+        {
+            tmgr.ConfigureScheduling(threadsConfig);
+        }
 
         // Start the thread
         spdlog::info("Target start reached!");
@@ -189,6 +369,7 @@ namespace SCI::BAT
         // Thread loop
         auto& kbInterrupt = SCI::Util::KeyboardInterrupt::Get();
         kbInterrupt.SetLogger(spdlog::default_logger());
+        kbInterrupt.SetCallback(+[](int, SCI::BAT::ThreadManager* manager) { manager->Notify(); }, &tmgr);
         kbInterrupt.Register();
         while (tmgr())
         {
@@ -197,11 +378,20 @@ namespace SCI::BAT
                 spdlog::info("Stop request received! Terminating modules");
                 tmgr.Stop();
             }
-            std::this_thread::yield();
+            else
+            {
+                // Sleep until a thread or the signal handler reports an event
+                tmgr.WaitForEvent();
+            }
         }
         tmgr.Wait();
         spdlog::info("Target stop reached!");
 
+        // Last checkpoint of the staged settings
+        SCI_ASSERT(Config::UqlJson::Get().Checkpoint(), "Failed to commit the staged settings");
+        auto dbStats = Config::UqlJson::Get().GetStats();
+        spdlog::info("Config database: {} checkpoints, {} coalesced writes", dbStats.checkpoints, dbStats.coalesced);
+
         // Application termination routines
         mosquitto_lib_cleanup();
 
@@ -239,9 +429,10 @@ int main(int argc, char** argv)
     spdlog::set_default_logger(SCI::BAT::CreateLogger(args, "main"));
 
     // Invoke guarded main
+    int result = -1;
     try
     {
-        return SCI::BAT::GuardedMain(args);
+        result = SCI::BAT::GuardedMain(args);
     }
     catch (std::exception& ex)
     {
@@ -252,5 +443,7 @@ int main(int argc, char** argv)
         spdlog::critical("Unknown exception in main.");
     }
 
-    return -1;
+    // Write all queued messages
+    spdlog::shutdown();
+    return result;
 }
@@ -0,0 +1,4 @@
+-- Compares the text and the binary (CBOR) encoding of config values
+reti_new_project("ConfigBenchmark", "src/example/ConfigBenchmark")
+reti_executable()
+reti_cpp()
@@ -0,0 +1,98 @@
+/*
+ *      Compares parse and serialize cost of the config value encodings
+ *
+ *      Usage: ConfigBenchmark [iterations]
+ *      The records mirror what the sci-bat-service rereads constantly (users, sessions and module configs).
+ *      "text" is the encoding of older databases (nlohmann::to_string), "cbor" the current one (self-describe tag + CBOR).
+ *
+ *      Author: Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+
+#include <nlohmann/json.hpp>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Same layout as SCI::BAT::Config::UqlJson::Serialize
+static const char BinaryTag[3] = { (char)0xD9, (char)0xD9, (char)0xF7 };
+
+struct Record
+{
+    const char* name;
+    nlohmann::json value;
+};
+
+template<typename F>
+double Measure(size_t iterations, F&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        func();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main(int argc, char** argv)
+{
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    // Stored records (permission wrapper + data)
+    auto wrap = [](nlohmann::json data)
+        {
+            return nlohmann::json{ { "permission", { { "read", 2 }, { "write", 2 }, { "delete", 3 } } }, { "data", std::move(data) } };
+        };
+    std::vector<Record> records = {
+        { "user", wrap({
+            { "password", "$argon2id$v=19$m=65536,t=2,p=1$c29tZXNhbHRzb21lc2FsdA$R4nD0mH4sHv4lu3F0rB3nchM4rk1nGpUrp0s3s" },
+            { "permission", 2 },
+            { "sessions", { "2b1e6f0c-5a0d-4c1f-9d52-7b0e4a1f3c21", "d3a9c0f2-8e14-4b6a-a3f7-0c5e9b2d1a48" } },
+        }) },
+        { "gateway", wrap({ { "address", "10.27.210.78" }, { "port", 502 }, { "node", 3 }, { "pollrate", 3000 } }) },
+        { "mailbox", wrap({
+            { "broker", { { "address", "localhost" }, { "username", "" }, { "password", "" }, { "port", 1883 } } },
+            { "basetopic", "sci-bat" },
+            { "spool", { { "size", 16 * 1024 * 1024 }, { "replayrate", 50 } } },
+            { "reconnect", { { "min", 1000 }, { "max", 60000 } } },
+            { "metrics", { { "interval", 10000 } } },
+            { "delivery", { { "inflight", 20 }, { "qos", { { "#", 0 }, { "battery/#", 1 }, { "inverter/#", 1 } } } } },
+        }) },
+    };
+
+    size_t sink = 0;
+    fmt::print("{:<10} {:>10} {:>10} {:>14} {:>14} {:>14} {:>14}\n", "record", "text [B]", "cbor [B]", "text ser [ns]", "cbor ser [ns]", "text parse [ns]", "cbor parse [ns]");
+    for (const auto& record : records)
+    {
+        std::string text = nlohmann::to_string(record.value);
+        std::string cbor(BinaryTag, sizeof(BinaryTag));
+        nlohmann::json::to_cbor(record.value, cbor);
+
+        // Round trip must be lossless
+        if (nlohmann::json::from_cbor(cbor.begin() + sizeof(BinaryTag), cbor.end()) != record.value)
+        {
+            fmt::print("CBOR round trip of \"{}\" failed!\n", record.name);
+            return -1;
+        }
+
+        double textSerialize = Measure(iterations, [&]() { sink += nlohmann::to_string(record.value).size(); });
+        double cborSerialize = Measure(iterations, [&]()
+            {
+                std::string data(BinaryTag, sizeof(BinaryTag));
+                nlohmann::json::to_cbor(record.value, data);
+                sink += data.size();
+            });
+        double textParse = Measure(iterations, [&]() { sink += nlohmann::json::parse(text).size(); });
+        double cborParse = Measure(iterations, [&]() { sink += nlohmann::json::from_cbor(cbor.begin() + sizeof(BinaryTag), cbor.end()).size(); });
+
+        fmt::print("{:<10} {:>10} {:>10} {:>14.0f} {:>14.0f} {:>14.0f} {:>14.0f}\n", record.name, text.size(), cbor.size(), textSerialize, cborSerialize, textParse, cborParse);
+    }
+
+    // Printing the sink keeps the measured calls from being optimized away
+    fmt::print("{} iterations per measurement (checksum {})\n", iterations, sink);
+
+    return 0;
+}
@@ -0,0 +1,5 @@
+-- Decoder for binary logs written by the service (--log-file)
+reti_new_project("LogDecoder", "src/example/LogDecoder")
+reti_executable()
+reti_cpp()
+links { "SCIUtil" }
@@ -0,0 +1,59 @@
+/*
+ *      Decodes binary logs written by the sci-bat-service (--log-file) to text
+ *
+ *      Usage: LogDecoder <log file> [minimum level (trace, debug, info, warning, error, critical)]
+ *      The output uses the same pattern as the console output of the service.
+ *
+ *      Author: Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+
+#include <SCIUtil/Logging/BinaryLogSink.h>
+
+#include <fmt/format.h>
+#include <fmt/chrono.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fmt::print("Usage: {} <log file> [minimum level]\n", argv[0]);
+        return -1;
+    }
+
+    // Open log
+    std::ifstream log(argv[1], std::ios::binary);
+    if (!log || !SCI::Util::BinaryLogSink::ReadHeader(log))
+    {
+        fmt::print("\"{}\" is not a binary log!\n", argv[1]);
+        return -1;
+    }
+    auto minLevel = argc > 2 ? spdlog::level::from_str(argv[2]) : spdlog::level::trace;
+
+    // Print records
+    SCI::Util::BinaryLogSink::Record record;
+    size_t count = 0;
+    while (log.peek() != std::char_traits<char>::eof())
+    {
+        // Truncated records are expected when the service was killed while writing
+        if (!SCI::Util::BinaryLogSink::ReadRecord(log, record))
+        {
+            fmt::print(stderr, "Log is truncated after {} records.\n", count);
+            return 1;
+        }
+
+        if (record.level >= minLevel)
+        {
+            auto seconds = std::chrono::floor<std::chrono::seconds>(record.time);
+            auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(record.time - seconds).count();
+            fmt::print("[{:%d.%m.%Y %H:%M:%S}.{:03}] [{}] [{}] [{}] {}\n", fmt::localtime(std::chrono::system_clock::to_time_t(seconds)), millis,
+                spdlog::level::to_string_view(record.level), record.threadId, record.logger, record.message);
+        }
+        count++;
+    }
+
+    return 0;
+}
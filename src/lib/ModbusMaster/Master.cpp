@@ -27,11 +27,14 @@ SCI::Modbus::Slave& SCI::Modbus::Master::SetupSlave(const std::string& name)
 
 bool SCI::Modbus::Master::IOUpdate(float deltaT)
 {
+    SCI_TRACE_SCOPE("modbus", "Master::IOUpdate");
+
     size_t errorCount = 0;
-    GetLogger()->debug("Slave update started.");
+    SCI_LOG_DEBUG(GetLogger(), "Slave update started.");
     for (auto& slave : m_slaves)
     {
-        GetLogger()->debug(R"(Updating slave "{}"...)", slave.first);
+        SCI_TRACE_SCOPE("modbus", slave.first);
+        SCI_LOG_DEBUG(GetLogger(), R"(Updating slave "{}"...)", slave.first);
         auto updateResult = slave.second.ExecuteIOUpdate(m_processImage, deltaT);
         switch (updateResult)
         {
@@ -48,10 +51,10 @@ bool SCI::Modbus::Master::IOUpdate(float deltaT)
                 errorCount++;
                 break;
             case Slave::IOUpdateResult::UpdateSuccess:
-                GetLogger()->debug(R"(Slave "{}" update finished successfully!)", slave.first);
+                SCI_LOG_DEBUG(GetLogger(), R"(Slave "{}" update finished successfully!)", slave.first);
                 break;
             case Slave::IOUpdateResult::FailedConnectionDelay:
-                GetLogger()->debug(R"(Slave "{}" is in connection delay!)", slave.first);
+                SCI_LOG_DEBUG(GetLogger(), R"(Slave "{}" is in connection delay!)", slave.first);
                 // errorCount++; Ommit to not spam console
                 break;
             case Slave::IOUpdateResult::ConnectionStilFailing:
@@ -68,7 +71,8 @@ bool SCI::Modbus::Master::IOUpdate(float deltaT)
     {
         GetLogger()->warn("Slave updates incomplete! Updated {}/{} slaves sucessfully.", m_slaves.size() - errorCount, m_slaves.size());
     }
-    GetLogger()->debug("Slave update finished.");
+    SCI_LOG_DEBUG(GetLogger(), "Slave update finished.");
+    SCI_TRACE_COUNTER("modbus", "Master::FailedSlaves", errorCount);
 
     return errorCount == 0;
 }
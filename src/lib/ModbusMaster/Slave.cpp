@@ -66,6 +66,8 @@ void SCI::Modbus::Slave::ValidateMapping(const Mapping& mapping) const
 
 SCI::Modbus::Slave::IOUpdateResult SCI::Modbus::Slave::ExecuteIOUpdate(ProcessImage& processImage, float deltaT)
 {
+    SCI_TRACE_SCOPE("modbus", "Slave::ExecuteIOUpdate");
+
     bool connectionRestored = false;
     m_lastUpdateOk = false;
 
@@ -108,6 +110,7 @@ SCI::Modbus::Slave::IOUpdateResult SCI::Modbus::Slave::ExecuteIOUpdate(ProcessIm
         // Update all mappings
         size_t errorCount = 0;
         m_connection.Execute([&](SCI::Modbus::MSConnection& c) {
+            SCI_TRACE_SCOPE("modbus", "Slave::TransferMappings");
             for (const auto& mapping : m_mappings)
             {
                 size_t bitCount = mapping.Remote.count * 8;
@@ -9,6 +9,7 @@
 #include <ModbusMaster/ProcessImage.h>
 
 #include <SCIUtil/SPDLogable.h>
+#include <SCIUtil/Trace/Tracer.h>
 
 #include <fmt/format.h>
 
@@ -0,0 +1,85 @@
+#include "AdaptiveLock.h"
+
+std::mutex SCI::Util::AdaptiveLock::s_registryMutex;
+SCI::Util::AdaptiveLock* SCI::Util::AdaptiveLock::s_registryHead = nullptr;
+
+SCI::Util::AdaptiveLock::AdaptiveLock(const char* name) :
+    m_name(name)
+{
+    if (m_name)
+    {
+        std::lock_guard janitor(s_registryMutex);
+        m_next = s_registryHead;
+        if (m_next)
+        {
+            m_next->m_prev = this;
+        }
+        s_registryHead = this;
+    }
+}
+
+SCI::Util::AdaptiveLock::~AdaptiveLock()
+{
+    if (m_name)
+    {
+        std::lock_guard janitor(s_registryMutex);
+        if (m_prev)
+        {
+            m_prev->m_next = m_next;
+        }
+        else
+        {
+            s_registryHead = m_next;
+        }
+        if (m_next)
+        {
+            m_next->m_prev = m_prev;
+        }
+    }
+}
+
+SCI::Util::AdaptiveLock::Stats SCI::Util::AdaptiveLock::GetStats() const noexcept
+{
+    Stats stats;
+    stats.acquisitions = m_acquisitions.load(std::memory_order::relaxed);
+    stats.contended = m_contended.load(std::memory_order::relaxed);
+    stats.parked = m_parked.load(std::memory_order::relaxed);
+    stats.holdTime = m_holdTime.Read();
+    return stats;
+}
+
+void SCI::Util::AdaptiveLock::ForEach(const std::function<void(const AdaptiveLock&)>& f)
+{
+    std::lock_guard janitor(s_registryMutex);
+    for (auto* lock = s_registryHead; lock; lock = lock->m_next)
+    {
+        f(*lock);
+    }
+}
+
+void SCI::Util::AdaptiveLock::AquireContended()
+{
+    m_contended.fetch_add(1, std::memory_order::relaxed);
+    LockWait wait;
+
+    // Spin with exponential backoff (only reading the lock word to keep the cache line shared)
+    for (unsigned int round = 0; round < SpinRounds; round++)
+    {
+        for (unsigned int i = 0; i < (1u << round); i++)
+        {
+            Pause();
+        }
+        if (m_state.load(std::memory_order::relaxed) == Unlocked && TryAquire())
+        {
+            return;
+        }
+    }
+
+    // Park: Mark the lock as having waiters and sleep until the owner releases it
+    m_parked.fetch_add(1, std::memory_order::relaxed);
+    while (m_state.exchange(LockedWaiting, std::memory_order::acquire) != Unlocked)
+    {
+        m_state.wait(LockedWaiting, std::memory_order::relaxed);
+    }
+    Acquired();
+}
@@ -0,0 +1,156 @@
+ /*!
+  * @file AdaptiveLock.h
+  * @brief Lock that spins briefly and then parks the thread (Atomic wait).
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <SCIUtil/Concurrent/ILock.h>
+#include <SCIUtil/Metrics/Histogram.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Hybrid lock for critical sections that may block (disk or socket I/O).
+     *
+     * A contended acquisition spins for a short time using the CPU pause instruction. When the lock is still not free the thread is parked
+     * with std::atomic::wait (futex on Linux, WaitOnAddress on Windows) until the owner releases the lock.
+     * Every lock records contention counters and a histogram of hold times. Named locks can be enumerated via ForEach().
+    */
+    class AdaptiveLock : public ILock
+    {
+        public:
+            /*!
+             * @brief Contention statistics of a lock
+            */
+            struct Stats
+            {
+                /*! Number of acquisitions */
+                uint64_t acquisitions = 0;
+                /*! Acquisitions that found the lock taken */
+                uint64_t contended = 0;
+                /*! Acquisitions that had to park the thread */
+                uint64_t parked = 0;
+                /*! Time the lock was held (nanoseconds) */
+                Histogram::Snapshot holdTime;
+            };
+
+        public:
+            /*!
+             * @brief Creates a new lock
+             * @param name Name for reporting. Must outlive the lock. Unnamed locks are not registered for ForEach().
+            */
+            AdaptiveLock(const char* name = nullptr);
+            AdaptiveLock(const AdaptiveLock&) = delete;
+            AdaptiveLock(AdaptiveLock&&) noexcept = delete;
+            ~AdaptiveLock();
+
+            AdaptiveLock& operator=(const AdaptiveLock&) = delete;
+            AdaptiveLock& operator=(AdaptiveLock&&) noexcept = delete;
+
+            bool TryAquire() override
+            {
+                uint32_t expected = Unlocked;
+                if (m_state.compare_exchange_strong(expected, Locked, std::memory_order::acquire, std::memory_order::relaxed))
+                {
+                    Acquired();
+                    return true;
+                }
+                return false;
+            }
+
+            void Aquire() override
+            {
+                if (!TryAquire())
+                {
+                    AquireContended();
+                }
+            }
+
+            void Release() override
+            {
+                m_holdTime.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_acquiredAt).count());
+                if (m_state.exchange(Unlocked, std::memory_order::release) == LockedWaiting)
+                {
+                    m_state.notify_one();
+                }
+            }
+
+            /*!
+             * @brief Retrieves the name of the lock
+             * @return Name (or nullptr)
+            */
+            inline const char* GetName() const noexcept
+            {
+                return m_name;
+            }
+            /*!
+             * @brief Reads the contention statistics (lock free)
+             * @return Current statistics
+            */
+            Stats GetStats() const noexcept;
+
+            /*!
+             * @brief Calls f for every named lock alive
+             * @param f Callback function
+            */
+            static void ForEach(const std::function<void(const AdaptiveLock&)>& f);
+
+            /*!
+             * @brief Hints the CPU that the current thread is spinning
+            */
+            static inline void Pause() noexcept
+            {
+                #if defined(_MSC_VER)
+                _mm_pause();
+                #elif defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+                #elif defined(__aarch64__) || defined(__arm__)
+                asm volatile("yield");
+                #endif
+            }
+
+        private:
+            void AquireContended();
+
+            inline void Acquired() noexcept
+            {
+                m_acquiredAt = std::chrono::steady_clock::now();
+                m_acquisitions.fetch_add(1, std::memory_order::relaxed);
+            }
+
+        private:
+            // Lock word states
+            static constexpr uint32_t Unlocked = 0;
+            static constexpr uint32_t Locked = 1;
+            static constexpr uint32_t LockedWaiting = 2;
+
+            // Number of spin rounds before parking (each round pauses twice as often as the last one)
+            static constexpr unsigned int SpinRounds = 7;
+
+            std::atomic<uint32_t> m_state = Unlocked;
+            std::chrono::steady_clock::time_point m_acquiredAt;
+
+            std::atomic<uint64_t> m_acquisitions = 0;
+            std::atomic<uint64_t> m_contended = 0;
+            std::atomic<uint64_t> m_parked = 0;
+            Histogram m_holdTime;
+
+            const char* m_name = nullptr;
+            AdaptiveLock* m_prev = nullptr;
+            AdaptiveLock* m_next = nullptr;
+
+            static std::mutex s_registryMutex;
+            static AdaptiveLock* s_registryHead;
+    };
+}
@@ -5,6 +5,8 @@
   */
 #pragma once
 
+#include <SCIUtil/Concurrent/LockWait.h>
+
 #include <type_traits>
 #include <thread>
 
@@ -29,6 +31,19 @@ namespace SCI::Util
             */
             virtual void Release() = 0;
 
+            /*!
+             * @brief Aquires the lock using the locks own waiting strategy (Default: yield as long as TryAquire() fails).
+            */
+            virtual void Aquire()
+            {
+                if (TryAquire())
+                    return;
+
+                LockWait wait;
+                while (!TryAquire())
+                    std::this_thread::yield();
+            }
+
             /*!
              * @brief Aquires th lock. Will call the pause function with supplied arguments as long as TryAquire() failes.
              * @tparam PF Type of pause function.
@@ -0,0 +1,46 @@
+ /*!
+  * @file ISharedLock.h
+  * @brief Interface for concurrent locks that can be shared by multiple readers.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <SCIUtil/Concurrent/ILock.h>
+
+#include <thread>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Interface defining the behavior of reader / writer locks.
+     * 
+     * The exclusive (writer) side is accessed through the ILock functions. The shared (reader) side is accessed through the *Shared functions.
+    */
+    class ISharedLock : public ILock
+    {
+        public:
+            /*!
+             * @brief Tries to acquire the lock in shared mode.
+             * @return True if lock was acquired. False if acquisition fails.
+            */
+            virtual bool TryAquireShared() = 0;
+
+            /*!
+             * @brief Releases a shared lock.
+            */
+            virtual void ReleaseShared() = 0;
+
+            /*!
+             * @brief Aquires the lock in shared mode using the locks own waiting strategy (Default: yield as long as TryAquireShared() fails).
+            */
+            virtual void AquireShared()
+            {
+                if (TryAquireShared())
+                    return;
+
+                LockWait wait;
+                while (!TryAquireShared())
+                    std::this_thread::yield();
+            }
+    };
+}
@@ -19,6 +19,15 @@ namespace SCI::Util
     class LockGuard
     {
         public:
+            /*!
+             * @brief Creates a new LockGuard based on a lock. Will block (using the waiting strategy of the lock) until lock was acquired.
+             * @param lock Reference to lock that shall be guarded.
+            */
+            LockGuard(ILock& lock) :
+                m_lock(lock)
+            {
+                m_lock.Aquire();
+            }
             /*!
              * @brief Creates a new LockGuard based on a lock. Will block (call pause function) until lock was acquired.
              * @tparam PF Type of pause function.  
@@ -0,0 +1,51 @@
+ /*!
+  * @file LockWait.h
+  * @brief Accounts the time a thread spends waiting for locks.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Measures a lock wait from construction to destruction.
+     *
+     * Locks create an instance only on their contended path. The measured time is added to the counter attached to the calling thread (if any).
+    */
+    class LockWait
+    {
+        public:
+            LockWait() = default;
+            LockWait(const LockWait&) = delete;
+            LockWait(LockWait&&) noexcept = delete;
+            ~LockWait()
+            {
+                if (s_counter)
+                {
+                    auto waitTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+                    s_counter->fetch_add((uint64_t)waitTime.count(), std::memory_order::relaxed);
+                }
+            }
+
+            LockWait& operator=(const LockWait&) = delete;
+            LockWait& operator=(LockWait&&) noexcept = delete;
+
+            /*!
+             * @brief Attaches a counter to the calling thread
+             * @param counter Counter receiving the wait time in nanoseconds (nullptr to detach). Must outlive the attachment.
+            */
+            static inline void Attach(std::atomic<uint64_t>* counter) noexcept
+            {
+                s_counter = counter;
+            }
+
+        private:
+            std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+
+            static inline thread_local std::atomic<uint64_t>* s_counter = nullptr;
+    };
+}
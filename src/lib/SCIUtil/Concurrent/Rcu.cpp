@@ -0,0 +1,103 @@
+#include "Rcu.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+std::atomic<uint64_t> SCI::Util::Rcu::s_epoch = 1;
+std::atomic<SCI::Util::Rcu::Slot*> SCI::Util::Rcu::s_slots = nullptr;
+thread_local SCI::Util::Rcu::ThreadSlot SCI::Util::Rcu::s_threadSlot;
+std::mutex SCI::Util::Rcu::s_retiredMutex;
+SCI::Util::Rcu::RetiredList SCI::Util::Rcu::s_retired;
+
+SCI::Util::Rcu::ThreadSlot::~ThreadSlot()
+{
+    if (slot)
+    {
+        slot->epoch.store(0, std::memory_order::release);
+        slot->used.clear(std::memory_order::release);
+    }
+}
+
+SCI::Util::Rcu::RetiredList::~RetiredList()
+{
+    for (auto& retired : objects)
+    {
+        retired.deleter();
+    }
+}
+
+void SCI::Util::Rcu::Retire(std::function<void()> deleter)
+{
+    // Readers announcing this epoch (or a newer one) loaded the replacement
+    uint64_t epoch = s_epoch.fetch_add(1, std::memory_order::seq_cst) + 1;
+
+    std::vector<Retired> reclaimable;
+    std::unique_lock janitor(s_retiredMutex);
+    auto& retiredObjects = s_retired.objects;
+    retiredObjects.push_back({ epoch, std::move(deleter) });
+
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    for (Slot* slot = s_slots.load(std::memory_order::seq_cst); slot; slot = slot->next)
+    {
+        uint64_t announced = slot->epoch.load(std::memory_order::seq_cst);
+        if (announced)
+        {
+            oldest = std::min(oldest, announced);
+        }
+    }
+
+    auto itReclaimable = std::partition(retiredObjects.begin(), retiredObjects.end(), [oldest](const Retired& retired) { return retired.epoch > oldest; });
+    std::move(itReclaimable, retiredObjects.end(), std::back_inserter(reclaimable));
+    retiredObjects.erase(itReclaimable, retiredObjects.end());
+    janitor.unlock();
+
+    for (auto& retired : reclaimable)
+    {
+        retired.deleter();
+    }
+}
+
+void SCI::Util::Rcu::Enter()
+{
+    auto& threadSlot = s_threadSlot;
+    if (threadSlot.depth++ == 0)
+    {
+        if (!threadSlot.slot)
+        {
+            threadSlot.slot = AcquireSlot();
+        }
+
+        // The announcement must be visible before the protected pointer is loaded
+        threadSlot.slot->epoch.store(s_epoch.load(std::memory_order::seq_cst), std::memory_order::seq_cst);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+    }
+}
+
+void SCI::Util::Rcu::Leave() noexcept
+{
+    auto& threadSlot = s_threadSlot;
+    if (--threadSlot.depth == 0)
+    {
+        threadSlot.slot->epoch.store(0, std::memory_order::release);
+    }
+}
+
+SCI::Util::Rcu::Slot* SCI::Util::Rcu::AcquireSlot()
+{
+    // Reuse the slot of an exited thread
+    for (Slot* slot = s_slots.load(std::memory_order::acquire); slot; slot = slot->next)
+    {
+        if (!slot->used.test_and_set(std::memory_order::acquire))
+        {
+            return slot;
+        }
+    }
+
+    // Slots are never removed, a push only competes with other pushes
+    Slot* slot = new Slot();
+    slot->used.test_and_set(std::memory_order::relaxed);
+    slot->next = s_slots.load(std::memory_order::relaxed);
+    while (!s_slots.compare_exchange_weak(slot->next, slot, std::memory_order::seq_cst, std::memory_order::relaxed));
+    return slot;
+}
@@ -0,0 +1,155 @@
+ /*!
+  * @file Rcu.h
+  * @brief Read copy update: Lock free publication of immutable objects with epoch based reclamation.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Epoch based reclamation shared by all RcuPointer instances.
+     *
+     * Every reading thread owns a slot in which it announces the global epoch while it is inside a read section. Entering and leaving a
+     * section only writes the own slot (no shared cache line, no lock). Replaced objects are retired with the epoch of their replacement
+     * and deleted by a later writer once no slot announces an older epoch.
+    */
+    class Rcu
+    {
+        private:
+            /*!
+             * @brief Epoch announcement of a thread (never freed, reused after the thread exited)
+            */
+            struct Slot
+            {
+                /*! Announced epoch (zero: outside of a read section) */
+                std::atomic<uint64_t> epoch = 0;
+                /*! Set while a thread owns the slot */
+                std::atomic_flag used;
+                /*! Next slot of the registry */
+                Slot* next = nullptr;
+            };
+
+            /*!
+             * @brief Object waiting for the readers of older epochs
+            */
+            struct Retired
+            {
+                uint64_t epoch;
+                std::function<void()> deleter;
+            };
+            /*!
+             * @brief Retired objects (the remaining ones are deleted on exit)
+            */
+            struct RetiredList
+            {
+                std::vector<Retired> objects;
+
+                ~RetiredList();
+            };
+
+        public:
+            /*!
+             * @brief Read section. Objects loaded from a RcuPointer stay valid until the guard is destroyed. Guards can be nested.
+            */
+            class ReadGuard
+            {
+                public:
+                    ReadGuard()
+                    {
+                        Rcu::Enter();
+                    }
+                    ReadGuard(const ReadGuard&) = delete;
+                    ReadGuard(ReadGuard&&) noexcept = delete;
+                    ~ReadGuard()
+                    {
+                        Rcu::Leave();
+                    }
+
+                    ReadGuard& operator=(const ReadGuard&) = delete;
+                    ReadGuard& operator=(ReadGuard&&) noexcept = delete;
+            };
+
+            /*!
+             * @brief Deletes an object once all read sections that could have loaded it have ended.
+             *
+             * Must be called after the object was replaced. Objects that are still in use are deleted by a later call.
+             * @param deleter Deletes the object.
+            */
+            static void Retire(std::function<void()> deleter);
+
+        private:
+            static void Enter();
+            static void Leave() noexcept;
+            static Slot* AcquireSlot();
+
+            /*!
+             * @brief Binds a slot to a thread and releases it on thread exit
+            */
+            struct ThreadSlot
+            {
+                Slot* slot = nullptr;
+                uint32_t depth = 0;
+
+                ~ThreadSlot();
+            };
+
+        private:
+            static std::atomic<uint64_t> s_epoch;
+            static std::atomic<Slot*> s_slots;
+            static thread_local ThreadSlot s_threadSlot;
+
+            static std::mutex s_retiredMutex;
+            static RetiredList s_retired;
+    };
+
+    /*!
+     * @brief Pointer to an immutable object. Readers load it lock free inside a Rcu::ReadGuard, writers replace it.
+     * @tparam T Type of the object
+    */
+    template<typename T>
+    class RcuPointer
+    {
+        public:
+            RcuPointer() = default;
+            RcuPointer(const RcuPointer&) = delete;
+            RcuPointer(RcuPointer&&) noexcept = delete;
+            ~RcuPointer()
+            {
+                delete m_object.load(std::memory_order::relaxed);
+            }
+
+            RcuPointer& operator=(const RcuPointer&) = delete;
+            RcuPointer& operator=(RcuPointer&&) noexcept = delete;
+
+            /*!
+             * @brief Loads the current object. Only valid while the calling thread holds a Rcu::ReadGuard (or serializes all Store() calls).
+             * @return Current object (nullptr if none was stored)
+            */
+            inline const T* Load() const noexcept
+            {
+                return m_object.load(std::memory_order::seq_cst);
+            }
+            /*!
+             * @brief Publishes a new object and retires the previous one. Concurrent writers must be serialized by the caller.
+             * @param object New object (ownership is taken)
+            */
+            inline void Store(const T* object)
+            {
+                const T* previous = m_object.exchange(object, std::memory_order::seq_cst);
+                if (previous)
+                {
+                    Rcu::Retire([previous]() { delete previous; });
+                }
+            }
+
+        private:
+            std::atomic<const T*> m_object = nullptr;
+    };
+}
@@ -0,0 +1,123 @@
+ /*!
+  * @file SeqLock.h
+  * @brief Sequence lock for small trivially copyable values.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <SCIUtil/Concurrent/SpinLock.h>
+#include <SCIUtil/Concurrent/LockGuard.h>
+#include <SCIUtil/Concurrent/AdaptiveLock.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Holds a value that is read much more often than written.
+     * 
+     * Readers never write shared memory and never block writers. They copy the value and retry when a write happened in the meantime.
+     * Writers are serialized by an internal lock. The value is stored as atomic words so concurrent copies are free of data races.
+     * @tparam T Type of the value (trivially copyable and default constructible).
+    */
+    template<typename T>
+    class SeqLock
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+        static_assert(std::is_default_constructible_v<T>, "SeqLock requires a default constructible type");
+
+        public:
+            SeqLock()
+            {
+                Write(T());
+            }
+            SeqLock(const T& value)
+            {
+                Write(value);
+            }
+            SeqLock(const SeqLock&) = delete;
+            SeqLock(SeqLock&&) noexcept = delete;
+
+            SeqLock& operator=(const SeqLock&) = delete;
+            SeqLock& operator=(SeqLock&&) noexcept = delete;
+
+            /*!
+             * @brief Reads a consistent copy of the value
+             * @return Copy of the value
+            */
+            T Load() const noexcept
+            {
+                std::array<uint64_t, WordCount> buffer;
+                while (true)
+                {
+                    uint32_t sequence = m_sequence.load(std::memory_order::acquire);
+                    if (sequence & 1)
+                    {
+                        // Write in progress
+                        AdaptiveLock::Pause();
+                        continue;
+                    }
+
+                    for (size_t i = 0; i < WordCount; i++)
+                        buffer[i] = m_data[i].load(std::memory_order::relaxed);
+
+                    std::atomic_thread_fence(std::memory_order::acquire);
+                    if (m_sequence.load(std::memory_order::relaxed) == sequence)
+                        break;
+                }
+
+                T value;
+                memcpy(static_cast<void*>(&value), buffer.data(), sizeof(T));
+                return value;
+            }
+
+            /*!
+             * @brief Replaces the value
+             * @param value New value
+            */
+            void Store(const T& value)
+            {
+                LockGuard janitor(m_writeLock);
+                Write(value);
+            }
+
+            /*!
+             * @brief Modifies the value (read, modify, write without interference of other writers)
+             * @tparam F Type of the modification function. Invoked as f(T&).
+             * @param f Modification function
+            */
+            template<typename F, typename = std::enable_if_t<std::is_invocable_v<F, T&>>>
+            void Update(F&& f)
+            {
+                LockGuard janitor(m_writeLock);
+                T value = Load();
+                f(value);
+                Write(value);
+            }
+
+        private:
+            void Write(const T& value) noexcept
+            {
+                std::array<uint64_t, WordCount> buffer = {};
+                memcpy(buffer.data(), static_cast<const void*>(&value), sizeof(T));
+
+                uint32_t sequence = m_sequence.load(std::memory_order::relaxed);
+                m_sequence.store(sequence + 1, std::memory_order::relaxed);
+                std::atomic_thread_fence(std::memory_order::release);
+                for (size_t i = 0; i < WordCount; i++)
+                    m_data[i].store(buffer[i], std::memory_order::relaxed);
+                m_sequence.store(sequence + 2, std::memory_order::release);
+            }
+
+        private:
+            static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+            std::atomic<uint32_t> m_sequence = 0;
+            std::array<std::atomic<uint64_t>, WordCount> m_data;
+            SpinLock m_writeLock;
+    };
+}
@@ -0,0 +1,144 @@
+ /*!
+  * @file SharedAdaptiveLock.h
+  * @brief Reader / writer lock that spins briefly and then parks the thread (Atomic wait).
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <SCIUtil/Concurrent/ISharedLock.h>
+#include <SCIUtil/Concurrent/AdaptiveLock.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Shared variant of the AdaptiveLock.
+     *
+     * Writers are serialized by an AdaptiveLock (spinning, parking and statistics are reported under the name of this lock) and then wait
+     * for the active readers to leave. Writers are preferred: As soon as a writer holds the lock no new readers are admitted. Readers that
+     * find a writer spin for a short time and are then parked until the writer releases the lock.
+    */
+    class SharedAdaptiveLock : public ISharedLock
+    {
+        public:
+            /*!
+             * @brief Creates a new lock
+             * @param name Name for reporting. Must outlive the lock. Unnamed locks are not registered for AdaptiveLock::ForEach().
+            */
+            SharedAdaptiveLock(const char* name = nullptr) :
+                m_writerLock(name)
+            {
+            }
+            SharedAdaptiveLock(const SharedAdaptiveLock&) = delete;
+            SharedAdaptiveLock(SharedAdaptiveLock&&) noexcept = delete;
+
+            SharedAdaptiveLock& operator=(const SharedAdaptiveLock&) = delete;
+            SharedAdaptiveLock& operator=(SharedAdaptiveLock&&) noexcept = delete;
+
+            bool TryAquire() override
+            {
+                if (!m_writerLock.TryAquire())
+                    return false;
+
+                uint32_t state = m_state.load(std::memory_order::relaxed) & ReadersWaiting;
+                if (m_state.compare_exchange_strong(state, state | Writer, std::memory_order::acquire, std::memory_order::relaxed))
+                    return true;
+
+                m_writerLock.Release();
+                return false;
+            }
+
+            void Aquire() override
+            {
+                m_writerLock.Aquire();
+
+                // Block new readers and wait for the active ones
+                uint32_t state = m_state.fetch_or(Writer, std::memory_order::acquire) | Writer;
+                if (state & ReaderMask)
+                {
+                    LockWait wait;
+                    do
+                    {
+                        m_state.wait(state, std::memory_order::acquire);
+                        state = m_state.load(std::memory_order::acquire);
+                    } while (state & ReaderMask);
+                }
+            }
+
+            void Release() override
+            {
+                if (m_state.fetch_and(~(Writer | ReadersWaiting), std::memory_order::release) & ReadersWaiting)
+                {
+                    m_state.notify_all();
+                }
+                m_writerLock.Release();
+            }
+
+            bool TryAquireShared() override
+            {
+                uint32_t state = m_state.load(std::memory_order::relaxed);
+                return !(state & Writer) && m_state.compare_exchange_weak(state, state + 1, std::memory_order::acquire, std::memory_order::relaxed);
+            }
+
+            void AquireShared() override
+            {
+                if (TryAquireShared())
+                    return;
+
+                LockWait wait;
+                for (unsigned int spins = 0; spins < SpinLimit; spins++)
+                {
+                    AdaptiveLock::Pause();
+                    if (TryAquireShared())
+                        return;
+                }
+
+                // Park: Mark readers as waiting and sleep until the writer releases the lock
+                while (!TryAquireShared())
+                {
+                    uint32_t state = m_state.load(std::memory_order::relaxed);
+                    if ((state & Writer) && !(state & ReadersWaiting))
+                    {
+                        state = m_state.fetch_or(ReadersWaiting, std::memory_order::relaxed) | ReadersWaiting;
+                    }
+                    if (state & Writer)
+                    {
+                        m_state.wait(state, std::memory_order::relaxed);
+                    }
+                }
+            }
+
+            void ReleaseShared() override
+            {
+                // The last reader wakes a writer waiting for the readers to leave
+                uint32_t state = m_state.fetch_sub(1, std::memory_order::release);
+                if ((state & Writer) && (state & ReaderMask) == 1)
+                {
+                    m_state.notify_all();
+                }
+            }
+
+            /*!
+             * @brief Reads the contention statistics of the writers (lock free)
+             * @return Current statistics
+            */
+            inline AdaptiveLock::Stats GetStats() const noexcept
+            {
+                return m_writerLock.GetStats();
+            }
+
+        private:
+            // Lock word: Number of readers and the flags below
+            static constexpr uint32_t Writer = 1u << 31;
+            static constexpr uint32_t ReadersWaiting = 1u << 30;
+            static constexpr uint32_t ReaderMask = ReadersWaiting - 1;
+
+            // Number of spins before a reader is parked
+            static constexpr unsigned int SpinLimit = 64;
+
+            AdaptiveLock m_writerLock;
+            std::atomic<uint32_t> m_state = 0;
+    };
+}
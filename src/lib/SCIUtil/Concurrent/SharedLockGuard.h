@@ -0,0 +1,60 @@
+ /*!
+  * @file SharedLockGuard.h
+  * @brief Automatically (scope based) guarding of the shared side of a lock.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <SCIUtil/Concurrent/ISharedLock.h>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Automatic shared lock controller class.
+     * 
+     * This class will acquire a lock in shared mode during its constructor. The lock is released on demand or on object destruction.
+    */
+    class SharedLockGuard
+    {
+        public:
+            /*!
+             * @brief Creates a new SharedLockGuard based on a lock. Will block until lock was acquired in shared mode.
+             * @param lock Reference to lock that shall be guarded.
+            */
+            SharedLockGuard(ISharedLock& lock) :
+                m_lock(lock)
+            {
+                m_lock.AquireShared();
+            }
+
+            SharedLockGuard(const SharedLockGuard&) = delete;
+            SharedLockGuard(SharedLockGuard&& other) noexcept = delete;
+
+            /*!
+             * @brief Destructor will release a pending lock.
+            */
+            ~SharedLockGuard()
+            {
+                Release();
+            }
+
+            SharedLockGuard& operator=(const SharedLockGuard&) = delete;
+            SharedLockGuard& operator=(SharedLockGuard&&) noexcept = delete;
+
+            /*!
+             * @brief This function will release the prior locked lock.
+            */
+            void Release()
+            {
+                if (m_aquired)
+                {
+                    m_lock.ReleaseShared();
+                    m_aquired = false;
+                }
+            }
+
+        private:
+            ISharedLock& m_lock;
+            bool m_aquired = true;
+    };
+}
@@ -0,0 +1,95 @@
+ /*!
+  * @file SharedSpinLock.h
+  * @brief Reader / writer spin lock (Atomic).
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <SCIUtil/Concurrent/ISharedLock.h>
+#include <SCIUtil/Concurrent/AdaptiveLock.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Implements a reader / writer spin lock.
+     * 
+     * Any number of readers can hold the lock at the same time. Writers are preferred: As soon as a writer waits no new readers are admitted.
+     * Waiting threads spin with the CPU pause instruction and yield after a short time. Meant for short critical sections without I/O.
+    */
+    class SharedSpinLock : public ISharedLock
+    {
+        public:
+            bool TryAquire() override
+            {
+                uint32_t state = m_state.load(std::memory_order::relaxed);
+                return (state & ~WriterWaiting) == 0 && m_state.compare_exchange_strong(state, Writer, std::memory_order::acquire, std::memory_order::relaxed);
+            }
+
+            void Aquire() override
+            {
+                if (TryAquire())
+                    return;
+
+                LockWait wait;
+                for (unsigned int spins = 0; !TryAquire(); spins++)
+                {
+                    // Block new readers
+                    uint32_t state = m_state.load(std::memory_order::relaxed);
+                    if (!(state & WriterWaiting) && (state & ~WriterWaiting) != 0)
+                    {
+                        m_state.fetch_or(WriterWaiting, std::memory_order::relaxed);
+                    }
+                    Backoff(spins);
+                }
+            }
+
+            void Release() override
+            {
+                // Keeps the waiting flag of other writers
+                m_state.fetch_and(~Writer, std::memory_order::release);
+            }
+
+            bool TryAquireShared() override
+            {
+                uint32_t state = m_state.load(std::memory_order::relaxed);
+                return !(state & (Writer | WriterWaiting)) && m_state.compare_exchange_weak(state, state + 1, std::memory_order::acquire, std::memory_order::relaxed);
+            }
+
+            void AquireShared() override
+            {
+                if (TryAquireShared())
+                    return;
+
+                LockWait wait;
+                for (unsigned int spins = 0; !TryAquireShared(); spins++)
+                {
+                    Backoff(spins);
+                }
+            }
+
+            void ReleaseShared() override
+            {
+                m_state.fetch_sub(1, std::memory_order::release);
+            }
+
+        private:
+            static inline void Backoff(unsigned int spins)
+            {
+                if (spins < SpinLimit)
+                    AdaptiveLock::Pause();
+                else
+                    std::this_thread::yield();
+            }
+
+        private:
+            static constexpr uint32_t Writer = 1u << 31;
+            static constexpr uint32_t WriterWaiting = 1u << 30;
+            static constexpr unsigned int SpinLimit = 64;
+
+            std::atomic<uint32_t> m_state = 0;
+    };
+}
@@ -7,6 +7,7 @@
 
 #include <SCIUtil/SPDLogable.h>
 
+#include <atomic>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
@@ -62,7 +63,7 @@ namespace SCI::Util
             void* m_callbackData = nullptr;
 
             bool m_registered = false;
-            bool m_interruptRecived = false;
+            std::atomic_bool m_interruptRecived = false; // Lock free: Set by the handler, which may run on any thread
 
         // Singleton
         public:
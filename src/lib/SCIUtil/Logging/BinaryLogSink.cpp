@@ -0,0 +1,99 @@
+#include "BinaryLogSink.h"
+
+#include <SCIUtil/Exception.h>
+
+#include <algorithm>
+#include <cstring>
+
+SCI::Util::BinaryLogSink::BinaryLogSink(const std::filesystem::path& path)
+{
+    m_file = std::fopen(path.string().c_str(), "ab");
+    SCI_ASSERT_FMT(m_file, "Failed to open binary log \"{}\"", path.generic_string());
+
+    // New file: Write the header
+    std::fseek(m_file, 0, SEEK_END);
+    if (std::ftell(m_file) == 0)
+    {
+        std::fwrite(Magic, 1, sizeof(Magic), m_file);
+    }
+}
+
+SCI::Util::BinaryLogSink::~BinaryLogSink()
+{
+    if (m_file)
+    {
+        std::fclose(m_file);
+    }
+}
+
+bool SCI::Util::BinaryLogSink::ReadHeader(std::istream& stream)
+{
+    char magic[sizeof(Magic)];
+    return stream.read(magic, sizeof(magic)) && std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+bool SCI::Util::BinaryLogSink::ReadRecord(std::istream& stream, Record& record)
+{
+    uint32_t size = 0;
+    if (!stream.read((char*)&size, sizeof(size)))
+        return false;
+
+    std::string data(size, '\0');
+    if (!stream.read(data.data(), size))
+        return false;
+
+    // Fields (bounds checked, a corrupted size must not read past the record)
+    size_t offset = 0;
+    auto read = [&](void* target, size_t length)
+        {
+            if (offset + length > data.size())
+                return false;
+            std::memcpy(target, data.data() + offset, length);
+            offset += length;
+            return true;
+        };
+
+    uint64_t time = 0;
+    uint8_t level = 0;
+    uint16_t loggerLength = 0;
+    uint32_t messageLength = 0;
+    if (!read(&time, sizeof(time)) || !read(&level, sizeof(level)) || !read(&record.threadId, sizeof(record.threadId)) || !read(&loggerLength, sizeof(loggerLength)))
+        return false;
+    record.logger.resize(loggerLength);
+    if (!read(record.logger.data(), loggerLength) || !read(&messageLength, sizeof(messageLength)))
+        return false;
+    record.message.resize(messageLength);
+    if (!read(record.message.data(), messageLength))
+        return false;
+
+    record.time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(time)));
+    record.level = (spdlog::level::level_enum)level;
+    return true;
+}
+
+void SCI::Util::BinaryLogSink::sink_it_(const spdlog::details::log_msg& msg)
+{
+    uint64_t time = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+    uint8_t level = (uint8_t)msg.level;
+    uint64_t threadId = (uint64_t)msg.thread_id;
+    uint16_t loggerLength = (uint16_t)std::min<size_t>(msg.logger_name.size(), UINT16_MAX);
+    uint32_t messageLength = (uint32_t)msg.payload.size();
+    uint32_t size = (uint32_t)(sizeof(time) + sizeof(level) + sizeof(threadId) + sizeof(loggerLength) + loggerLength + sizeof(messageLength) + messageLength);
+
+    // Assemble the record in the reused buffer (one write per record)
+    m_buffer.clear();
+    m_buffer.append((const char*)&size, sizeof(size));
+    m_buffer.append((const char*)&time, sizeof(time));
+    m_buffer.append((const char*)&level, sizeof(level));
+    m_buffer.append((const char*)&threadId, sizeof(threadId));
+    m_buffer.append((const char*)&loggerLength, sizeof(loggerLength));
+    m_buffer.append(msg.logger_name.data(), loggerLength);
+    m_buffer.append((const char*)&messageLength, sizeof(messageLength));
+    m_buffer.append(msg.payload.data(), messageLength);
+    std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+}
+
+void SCI::Util::BinaryLogSink::flush_()
+{
+    std::fflush(m_file);
+}
@@ -0,0 +1,85 @@
+ /*!
+  * @file BinaryLogSink.h
+  * @brief SPDLog sink writing unformatted binary records (decoded offline).
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/details/log_msg.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <string>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Sink that appends log messages as binary records instead of formatting them with a pattern.
+     *
+     * File layout (host byte order): 8 byte magic "SCIBLOG1", followed by records of
+     * { u32 size of the remaining record, u64 nanoseconds since the unix epoch, u8 level, u64 thread id, u16 logger name length, logger name, u32 message length, message }.
+    */
+    class BinaryLogSink : public spdlog::sinks::base_sink<std::mutex>
+    {
+        public:
+            /*! File magic (includes the format version) */
+            static constexpr char Magic[8] = { 'S', 'C', 'I', 'B', 'L', 'O', 'G', '1' };
+
+            /*!
+             * @brief One decoded record
+            */
+            struct Record
+            {
+                /*! Time of the message */
+                std::chrono::system_clock::time_point time;
+                /*! Level of the message */
+                spdlog::level::level_enum level = spdlog::level::off;
+                /*! Thread that logged the message */
+                uint64_t threadId = 0;
+                /*! Name of the logger */
+                std::string logger;
+                /*! Message text */
+                std::string message;
+            };
+
+        public:
+            /*!
+             * @brief Opens the file (appends to an existing log)
+             * @param path Path of the log file
+            */
+            BinaryLogSink(const std::filesystem::path& path);
+            BinaryLogSink(const BinaryLogSink&) = delete;
+            BinaryLogSink(BinaryLogSink&&) noexcept = delete;
+            ~BinaryLogSink();
+
+            BinaryLogSink& operator=(const BinaryLogSink&) = delete;
+            BinaryLogSink& operator=(BinaryLogSink&&) noexcept = delete;
+
+            /*!
+             * @brief Checks the magic at the beginning of a log
+             * @param stream Binary input stream
+             * @return True if the stream contains a binary log
+            */
+            static bool ReadHeader(std::istream& stream);
+            /*!
+             * @brief Reads the next record from a log
+             * @param stream Binary input stream (positioned after the header)
+             * @param record Receives the record
+             * @return False at the end of the log or when a record is truncated
+            */
+            static bool ReadRecord(std::istream& stream, Record& record);
+
+        protected:
+            void sink_it_(const spdlog::details::log_msg& msg) override;
+            void flush_() override;
+
+        private:
+            std::FILE* m_file = nullptr;
+            std::string m_buffer;
+    };
+}
@@ -0,0 +1,140 @@
+/*!
+ * @file Histogram.h
+ * @brief Lock free histogram with logarithmic buckets.
+ * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+ */
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <algorithm>
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Histogram of unsigned values in power of two buckets.
+     *
+     * Bucket n counts the values with a bit width of n (bucket 0: value 0, bucket 1: value 1, bucket 2: 2..3, bucket 3: 4..7, ...).
+     * Recording is wait free and may be done from any thread.
+    */
+    class Histogram
+    {
+        public:
+            /*! Number of buckets */
+            static constexpr size_t BucketCount = 40;
+
+            /*!
+             * @brief Copy of the histogram at one point in time
+            */
+            struct Snapshot
+            {
+                /*! Count per bucket */
+                std::array<uint64_t, BucketCount> buckets = {};
+                /*! Number of values recorded */
+                uint64_t count = 0;
+                /*! Sum of all values recorded */
+                uint64_t sum = 0;
+                /*! Largest value recorded */
+                uint64_t max = 0;
+
+                /*!
+                 * @brief Average of all values
+                 * @return Mean value (0 if empty)
+                */
+                inline double Mean() const noexcept
+                {
+                    return count ? (double)sum / count : 0.0;
+                }
+                /*!
+                 * @brief Estimates a percentile (upper bound of the bucket the percentile falls in)
+                 * @param p Percentile in the range 0.0 to 1.0
+                 * @return Estimated value
+                */
+                inline uint64_t Percentile(double p) const noexcept
+                {
+                    uint64_t target = (uint64_t)(std::clamp(p, 0.0, 1.0) * count);
+                    uint64_t seen = 0;
+                    for (size_t i = 0; i < BucketCount; i++)
+                    {
+                        seen += buckets[i];
+                        if (seen > target || (seen == count && seen))
+                        {
+                            return std::min(UpperBound(i), max);
+                        }
+                    }
+                    return max;
+                }
+            };
+
+        public:
+            /*!
+             * @brief Records a value
+             * @param value Value to be recorded
+            */
+            inline void Record(uint64_t value) noexcept
+            {
+                m_buckets[std::min<size_t>(std::bit_width(value), BucketCount - 1)].fetch_add(1, std::memory_order_relaxed);
+                m_count.fetch_add(1, std::memory_order_relaxed);
+                m_sum.fetch_add(value, std::memory_order_relaxed);
+
+                uint64_t max = m_max.load(std::memory_order_relaxed);
+                while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+            }
+
+            /*!
+             * @brief Reads the current state (not an atomic snapshot of all buckets)
+             * @return Snapshot of the histogram
+            */
+            inline Snapshot Read() const noexcept
+            {
+                Snapshot snapshot;
+                for (size_t i = 0; i < BucketCount; i++)
+                {
+                    snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+                    snapshot.count += snapshot.buckets[i];
+                }
+                snapshot.sum = m_sum.load(std::memory_order_relaxed);
+                snapshot.max = m_max.load(std::memory_order_relaxed);
+                return snapshot;
+            }
+
+            /*!
+             * @brief Removes all values
+            */
+            inline void Reset() noexcept
+            {
+                for (auto& bucket : m_buckets)
+                    bucket.store(0, std::memory_order_relaxed);
+                m_count.store(0, std::memory_order_relaxed);
+                m_sum.store(0, std::memory_order_relaxed);
+                m_max.store(0, std::memory_order_relaxed);
+            }
+
+            /*!
+             * @brief Number of values recorded
+             * @return Value count
+            */
+            inline uint64_t Count() const noexcept
+            {
+                return m_count.load(std::memory_order_relaxed);
+            }
+
+            /*!
+             * @brief Largest value that falls into a bucket
+             * @param bucket Index of the bucket
+             * @return Upper bound of the bucket
+            */
+            static constexpr uint64_t UpperBound(size_t bucket) noexcept
+            {
+                return bucket == 0 ? 0 : bucket >= 64 ? UINT64_MAX : (uint64_t(1) << bucket) - 1;
+            }
+
+        private:
+            std::array<std::atomic<uint64_t>, BucketCount> m_buckets = {};
+            std::atomic<uint64_t> m_count = 0;
+            std::atomic<uint64_t> m_sum = 0;
+            std::atomic<uint64_t> m_max = 0;
+    };
+}
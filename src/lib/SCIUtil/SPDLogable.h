@@ -9,8 +9,31 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/logger.h>
 
+/*
+ * Trace and debug output on hot paths. Calls below SPDLOG_ACTIVE_LEVEL (set by the build configuration) are removed at compile time,
+ * the remaining ones only format their arguments when the level is enabled on the logger. Removed calls still reference their
+ * arguments in an unevaluated context (no unused variable warnings, nothing is executed).
+ */
+#define SCI_LOG_DISCARD(logger, ...) ((void)sizeof(::SCI::Util::DiscardLog(logger, __VA_ARGS__)))
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define SCI_LOG_TRACE(logger, ...) SPDLOG_LOGGER_TRACE(logger, __VA_ARGS__)
+#else
+#define SCI_LOG_TRACE(logger, ...) SCI_LOG_DISCARD(logger, __VA_ARGS__)
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define SCI_LOG_DEBUG(logger, ...) SPDLOG_LOGGER_DEBUG(logger, __VA_ARGS__)
+#else
+#define SCI_LOG_DEBUG(logger, ...) SCI_LOG_DISCARD(logger, __VA_ARGS__)
+#endif
+
 namespace SCI::Util
 {
+    /*!
+     * @brief Signature used by SCI_LOG_DISCARD (only named in unevaluated contexts, never defined).
+    */
+    template<typename... Args>
+    int DiscardLog(const Args&... args) noexcept;
+
     /*!
      * @brief Base class that provides logging capability.
      * 
@@ -37,9 +60,9 @@ namespace SCI::Util
 
             /*!
              * @brief Returns the logger that is currently beeing used by this object.
-             * @return Pointer to spdlog logger.
+             * @return Pointer to spdlog logger (by reference, logging does not touch the reference count).
             */
-            inline std::shared_ptr<spdlog::logger> GetLogger() const
+            inline const std::shared_ptr<spdlog::logger>& GetLogger() const
             {
                 return m_logger;
             }
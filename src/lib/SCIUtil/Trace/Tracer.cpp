@@ -0,0 +1,188 @@
+#include "Tracer.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if defined(SCI_WINDOWS)
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(SCI_LINUX)
+#include <unistd.h>
+#endif
+
+std::atomic_bool SCI::Util::Tracer::s_enabled = false;
+const std::chrono::steady_clock::time_point SCI::Util::Tracer::s_epoch = std::chrono::steady_clock::now();
+std::mutex SCI::Util::Tracer::s_buffersMutex;
+std::vector<std::shared_ptr<SCI::Util::Tracer::Buffer>> SCI::Util::Tracer::s_buffers;
+thread_local SCI::Util::Tracer::ThreadBuffer SCI::Util::Tracer::s_threadBuffer;
+
+SCI::Util::Tracer::ThreadBuffer::~ThreadBuffer()
+{
+    // The events stay available until the next export
+    if (buffer)
+    {
+        buffer->finished.store(true, std::memory_order::release);
+    }
+}
+
+void SCI::Util::Tracer::SetThreadName(std::string_view name)
+{
+    auto* buffer = GetThreadBuffer();
+    std::lock_guard janitor(s_buffersMutex);
+    buffer->name = name;
+}
+
+std::string SCI::Util::Tracer::Export()
+{
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    auto out = std::back_inserter(json);
+    bool first = true;
+
+    // Names are copied from the events and can contain anything
+    auto writeString = [&](std::string_view str)
+        {
+            json.push_back('"');
+            for (char c : str)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    json.push_back('\\');
+                    json.push_back(c);
+                }
+                else if ((unsigned char)c < 0x20)
+                {
+                    fmt::format_to(out, "\\u{:04x}", (int)c);
+                }
+                else
+                {
+                    json.push_back(c);
+                }
+            }
+            json.push_back('"');
+        };
+
+    std::lock_guard janitor(s_buffersMutex);
+    for (const auto& buffer : s_buffers)
+    {
+        // Thread name
+        if (!buffer->name.empty())
+        {
+            fmt::format_to(out, "{}{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":", first ? "" : ",", buffer->tid);
+            writeString(buffer->name);
+            json.append("}}");
+            first = false;
+        }
+
+        // Events (oldest first)
+        uint64_t head = buffer->head.load(std::memory_order::acquire);
+        for (uint64_t index = head > BufferCapacity ? head - BufferCapacity : 0; index < head; index++)
+        {
+            const auto& slot = buffer->events[index % BufferCapacity];
+            uint32_t sequence = slot.sequence.load(std::memory_order::acquire);
+            Event event;
+            event.type = slot.type;
+            std::memcpy(event.name, slot.name, sizeof(event.name));
+            event.category = slot.category;
+            event.timestamp = slot.timestamp;
+            event.value = slot.value;
+            std::atomic_thread_fence(std::memory_order::acquire);
+            if (sequence != (uint32_t)(2 * index + 2) || slot.sequence.load(std::memory_order::relaxed) != sequence)
+            {
+                // Overwritten while reading
+                continue;
+            }
+            event.name[MaxNameLength] = '\0';
+
+            fmt::format_to(out, "{}{{\"ph\":\"{}\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"cat\":", first ? "" : ",", (char)event.type, buffer->tid, event.timestamp / 1000.0);
+            writeString(event.category ? event.category : "");
+            json.append(",\"name\":");
+            writeString(event.name);
+            switch (event.type)
+            {
+                case EventType::Span:
+                    fmt::format_to(out, ",\"dur\":{:.3f}}}", event.value / 1000.0);
+                    break;
+                case EventType::Instant:
+                    json.append(",\"s\":\"t\"}");
+                    break;
+                case EventType::Counter:
+                    fmt::format_to(out, ",\"args\":{{\"value\":{}}}}}", event.value);
+                    break;
+            }
+            first = false;
+        }
+    }
+
+    // Buffers of exited threads have been exported
+    std::erase_if(s_buffers, [](const auto& buffer) { return buffer->finished.load(std::memory_order::acquire); });
+
+    json.append("]}");
+    return json;
+}
+
+void SCI::Util::Tracer::Clear()
+{
+    // Readers skip everything older than the reset marks (the owning threads keep writing)
+    std::lock_guard janitor(s_buffersMutex);
+    for (auto& buffer : s_buffers)
+    {
+        for (auto& slot : buffer->events)
+        {
+            slot.sequence.store(0, std::memory_order::relaxed);
+        }
+    }
+    std::erase_if(s_buffers, [](const auto& buffer) { return buffer->finished.load(std::memory_order::acquire); });
+}
+
+void SCI::Util::Tracer::Record(EventType type, const char* category, std::string_view name, uint64_t timestamp, int64_t value) noexcept
+{
+    auto* buffer = GetThreadBuffer();
+    if (!buffer)
+        return;
+
+    // Single writer: Only the owning thread advances the head
+    uint64_t index = buffer->head.load(std::memory_order::relaxed);
+    auto& slot = buffer->events[index % BufferCapacity];
+    slot.sequence.store((uint32_t)(2 * index + 1), std::memory_order::relaxed);
+    std::atomic_thread_fence(std::memory_order::release);
+
+    slot.type = type;
+    size_t length = std::min(name.length(), MaxNameLength);
+    std::memcpy(slot.name, name.data(), length);
+    slot.name[length] = '\0';
+    slot.category = category;
+    slot.timestamp = timestamp;
+    slot.value = value;
+
+    slot.sequence.store((uint32_t)(2 * index + 2), std::memory_order::release);
+    buffer->head.store(index + 1, std::memory_order::release);
+}
+
+SCI::Util::Tracer::Buffer* SCI::Util::Tracer::GetThreadBuffer()
+{
+    if (!s_threadBuffer.buffer)
+    {
+        // First event of this thread
+        try
+        {
+            auto buffer = std::make_shared<Buffer>();
+            #if defined(SCI_WINDOWS)
+            buffer->tid = (int)GetCurrentThreadId();
+            #elif defined(SCI_LINUX)
+            buffer->tid = gettid();
+            #endif
+
+            std::lock_guard janitor(s_buffersMutex);
+            s_buffers.push_back(buffer);
+            s_threadBuffer.buffer = std::move(buffer);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+    return s_threadBuffer.buffer.get();
+}
@@ -0,0 +1,227 @@
+ /*!
+  * @file Tracer.h
+  * @brief Low overhead in process tracing (spans, counters and instant events) with Chrome trace export.
+  * @author Ludwig Fuechsl <ludwig.fuechsl@hm.edu>
+  */
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define SCI_TRACE_CONCAT_INNER(a, b) a##b
+#define SCI_TRACE_CONCAT(a, b) SCI_TRACE_CONCAT_INNER(a, b)
+
+#if defined(SCI_TRACE_DISABLED)
+#define SCI_TRACE_SCOPE(category, name)
+#define SCI_TRACE_INSTANT(category, name)
+#define SCI_TRACE_COUNTER(category, name, value)
+#else
+/*! Records a span from this line until the end of the enclosing scope. category must be a string literal */
+#define SCI_TRACE_SCOPE(category, name) ::SCI::Util::TraceSpan SCI_TRACE_CONCAT(sciTraceSpan, __LINE__)(category, name)
+/*! Records an instant event. category must be a string literal */
+#define SCI_TRACE_INSTANT(category, name) ::SCI::Util::Tracer::Instant(category, name)
+/*! Records the value of a counter. category must be a string literal */
+#define SCI_TRACE_COUNTER(category, name, value) ::SCI::Util::Tracer::Counter(category, name, (int64_t)(value))
+#endif
+
+namespace SCI::Util
+{
+    /*!
+     * @brief Process wide tracer.
+     *
+     * Every thread records into its own ring buffer (single producer, no locks, no allocations after the first event of the thread).
+     * Old events are overwritten when the buffer is full. Export() reads all buffers concurrently to the writers; events written
+     * while reading are detected by a per slot sequence number and skipped.
+    */
+    class Tracer
+    {
+        public:
+            /*! Events per thread */
+            static constexpr size_t BufferCapacity = 4096;
+            /*! Maximum length of an event name (longer names are truncated) */
+            static constexpr size_t MaxNameLength = 34;
+
+            /*!
+             * @brief Type of an event (values are the Chrome trace phases)
+            */
+            enum class EventType : char
+            {
+                /*! Span with start and duration */
+                Span = 'X',
+                /*! Point in time */
+                Instant = 'i',
+                /*! Value of a counter */
+                Counter = 'C',
+            };
+
+        private:
+            /*!
+             * @brief One slot of a ring buffer (one cache line)
+            */
+            struct Event
+            {
+                /*! 2 * index + 1 while writing, 2 * index + 2 when complete */
+                std::atomic<uint32_t> sequence = 0;
+                EventType type = EventType::Instant;
+                char name[MaxNameLength + 1] = {};
+                const char* category = nullptr;
+                /*! Nanoseconds since the tracer epoch */
+                uint64_t timestamp = 0;
+                /*! Duration (span) or value (counter) */
+                int64_t value = 0;
+            };
+
+            /*!
+             * @brief Ring buffer of one thread
+            */
+            struct Buffer
+            {
+                int tid = -1;
+                std::string name;
+                std::atomic<uint64_t> head = 0;
+                std::atomic_bool finished = false;
+                std::array<Event, BufferCapacity> events;
+            };
+
+            /*!
+             * @brief Owns the buffer of the calling thread (marks it finished on thread exit)
+            */
+            struct ThreadBuffer
+            {
+                ~ThreadBuffer();
+
+                std::shared_ptr<Buffer> buffer;
+            };
+
+        public:
+            /*!
+             * @brief Enables or disables recording (disabled by default, disabled tracing costs one relaxed load per event)
+             * @param enabled New state
+            */
+            static inline void SetEnabled(bool enabled) noexcept
+            {
+                s_enabled.store(enabled, std::memory_order::relaxed);
+            }
+            /*!
+             * @brief Checks if recording is enabled
+             * @return True if enabled
+            */
+            static inline bool IsEnabled() noexcept
+            {
+                return s_enabled.load(std::memory_order::relaxed);
+            }
+
+            /*!
+             * @brief Names the calling thread in the exported trace
+             * @param name Name of the thread
+            */
+            static void SetThreadName(std::string_view name);
+
+            /*!
+             * @brief Current time on the tracer clock
+             * @return Nanoseconds since the tracer epoch
+            */
+            static inline uint64_t Now() noexcept
+            {
+                return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+            }
+
+            /*!
+             * @brief Records a span
+             * @param category Category (string literal)
+             * @param name Name
+             * @param start Start on the tracer clock
+             * @param duration Duration in nanoseconds
+            */
+            static inline void Span(const char* category, std::string_view name, uint64_t start, uint64_t duration) noexcept
+            {
+                if (IsEnabled())
+                    Record(EventType::Span, category, name, start, (int64_t)duration);
+            }
+            /*!
+             * @brief Records an instant event
+             * @param category Category (string literal)
+             * @param name Name
+            */
+            static inline void Instant(const char* category, std::string_view name) noexcept
+            {
+                if (IsEnabled())
+                    Record(EventType::Instant, category, name, Now(), 0);
+            }
+            /*!
+             * @brief Records the value of a counter
+             * @param category Category (string literal)
+             * @param name Name of the counter
+             * @param value Current value
+            */
+            static inline void Counter(const char* category, std::string_view name, int64_t value) noexcept
+            {
+                if (IsEnabled())
+                    Record(EventType::Counter, category, name, Now(), value);
+            }
+
+            /*!
+             * @brief Exports all recorded events as Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+             * @return JSON document
+            */
+            static std::string Export();
+            /*!
+             * @brief Discards all recorded events
+            */
+            static void Clear();
+
+        private:
+            static void Record(EventType type, const char* category, std::string_view name, uint64_t timestamp, int64_t value) noexcept;
+            static Buffer* GetThreadBuffer();
+
+        private:
+            static std::atomic_bool s_enabled;
+            static const std::chrono::steady_clock::time_point s_epoch;
+
+            static std::mutex s_buffersMutex;
+            static std::vector<std::shared_ptr<Buffer>> s_buffers;
+
+            static thread_local ThreadBuffer s_threadBuffer;
+    };
+
+    /*!
+     * @brief Records a span from construction to destruction (use SCI_TRACE_SCOPE)
+    */
+    class TraceSpan
+    {
+        public:
+            /*!
+             * @brief Starts the span
+             * @param category Category (string literal)
+             * @param name Name. Must stay valid until the span ends.
+            */
+            TraceSpan(const char* category, std::string_view name) noexcept :
+                m_category(category), m_name(name), m_start(Tracer::IsEnabled() ? Tracer::Now() : 0)
+            {}
+            TraceSpan(const TraceSpan&) = delete;
+            TraceSpan(TraceSpan&&) noexcept = delete;
+            ~TraceSpan()
+            {
+                // Spans started while tracing was disabled are dropped
+                if (m_start)
+                {
+                    Tracer::Span(m_category, m_name, m_start, Tracer::Now() - m_start);
+                }
+            }
+
+            TraceSpan& operator=(const TraceSpan&) = delete;
+            TraceSpan& operator=(TraceSpan&&) noexcept = delete;
+
+        private:
+            const char* m_category;
+            std::string_view m_name;
+            uint64_t m_start;
+    };
+}